@@ -280,6 +280,44 @@ AOCSMoveTuple(TupleTableSlot *slot,
 		   AOTupleIdGet_segmentFileNum(&newAoTupleId), AOTupleIdGet_rowNum(&newAoTupleId));
 }
 
+/*
+ * Estimate the average number of rows in one block of a column of the
+ * segment file, for placing the vacuum delay points. pg_aocsseg.varblockcount
+ * is not maintained for column-oriented tables, so derive it from the
+ * uncompressed EOFs of the live column files instead. The number of live
+ * columns, which is the number of blocks read per block of rows, is
+ * returned in *nLiveColumns.
+ */
+static int64
+AOCSCompaction_TuplesPerBlock(Relation aorel, AOCSFileSegInfo *fsinfo,
+							  int *nLiveColumns)
+{
+	TupleDesc	tupDesc = RelationGetDescr(aorel);
+	int32		blocksize = aorel->rd_appendonly->blocksize;
+	int64		totalBlocks = 0;
+	int			nlive = 0;
+	int			i;
+
+	for (i = 0; i < Min(tupDesc->natts, fsinfo->vpinfo.nEntry); i++)
+	{
+		int64		eof = fsinfo->vpinfo.entry[i].eof_uncompressed;
+
+		if (tupDesc->attrs[i]->attisdropped)
+			continue;
+
+		nlive++;
+		totalBlocks += (eof + blocksize - 1) / blocksize;
+	}
+
+	*nLiveColumns = Max(nlive, 1);
+
+	if (totalBlocks == 0)
+		return INT_MAX;
+
+	/* less than one tuple per block if tuples span several blocks */
+	return Max(fsinfo->total_tupcount * nlive / totalBlocks, 1);
+}
+
 /*
  * Assumes that the segment file lock is already held.
  * Assumes that the segment file should be compacted.
@@ -304,17 +342,16 @@ AOCSSegmentFileFullCompaction(Relation aorel,
 	int			i;
 	AOTupleId  *aoTupleId;
 	int64		tupleCount = 0;
-	int64		tuplePerPage = INT_MAX;
+	int64		tuplePerPage;
+	int			nLiveColumns;
+	int64		movedSinceDelay = 0;
 
 	Assert(Gp_role == GP_ROLE_EXECUTE || Gp_role == GP_ROLE_UTILITY);
 	Assert(RelationIsAoCols(aorel));
 	Assert(insertDesc);
 
 	compact_segno = fsinfo->segno;
-	if (fsinfo->varblockcount > 0)
-	{
-		tuplePerPage = fsinfo->total_tupcount / fsinfo->varblockcount;
-	}
+	tuplePerPage = AOCSCompaction_TuplesPerBlock(aorel, fsinfo, &nLiveColumns);
 	relname = RelationGetRelationName(aorel);
 
 	AppendOnlyVisimap_Init(&visiMap,
@@ -366,6 +403,7 @@ AOCSSegmentFileFullCompaction(Relation aorel,
 						  resultRelInfo,
 						  estate);
 			movedTupleCount++;
+			movedSinceDelay++;
 		}
 		else
 		{
@@ -381,7 +419,11 @@ AOCSSegmentFileFullCompaction(Relation aorel,
 		tupleCount++;
 		if (VacuumCostActive && tupleCount % tuplePerPage == 0)
 		{
-			vacuum_delay_point();
+			AppendOnlyCompaction_VacuumDelayPoint(aorel,
+												  nLiveColumns,
+												  tuplePerPage,
+												  movedSinceDelay);
+			movedSinceDelay = 0;
 		}
 	}
 
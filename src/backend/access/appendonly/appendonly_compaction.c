@@ -40,6 +40,7 @@
 #include "nodes/execnodes.h"
 #include "storage/procarray.h"
 #include "storage/lmgr.h"
+#include "utils/faultinjector.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/relcache.h"
@@ -107,6 +108,45 @@ AppendOnlyCompaction_GetHideRatio(int64 hiddenTupcount, int64 totalTupcount)
 	return hideRatio;
 }
 
+/*
+ * Vacuum delay point for compaction, to be called after approximately one
+ * block of tuples has been scanned.
+ *
+ * Append-only segment files are read and written with their own buffered
+ * I/O instead of through shared buffers, so the buffer manager never adds to
+ * VacuumCostBalance during compaction and vacuum_cost_delay would have no
+ * effect. Charge the balance here instead: reading a block counts like a
+ * buffer miss per BLCKSZ of block size, and the part of it that is moved to
+ * the insert segment file counts like dirtying as many pages. blocksPerRow
+ * is the number of blocks each scanned row spans over, i.e. the number of
+ * column files for AOCS. The block size is an upper bound of the size on
+ * disk when the relation is compressed.
+ *
+ * Only called when VacuumCostActive is set.
+ */
+void
+AppendOnlyCompaction_VacuumDelayPoint(Relation aorel,
+									  int blocksPerRow,
+									  int64 scannedTupleCount,
+									  int64 movedTupleCount)
+{
+	int			pages;
+
+	Assert(VacuumCostActive);
+
+	pages = blocksPerRow * Max(aorel->rd_appendonly->blocksize / BLCKSZ, 1);
+
+	VacuumCostBalance += VacuumCostPageMiss * pages;
+	if (scannedTupleCount > 0)
+		VacuumCostBalance += (int) ((double) VacuumCostPageDirty * pages *
+									movedTupleCount / scannedTupleCount);
+
+	if (VacuumCostBalance >= VacuumCostLimit)
+		SIMPLE_FAULT_INJECTOR("appendonly_compaction_vacuum_delay");
+
+	vacuum_delay_point();
+}
+
 /*
  * Returns true iff the given segment file should be compacted.
  */
@@ -358,6 +398,7 @@ AppendOnlySegmentFileFullCompaction(Relation aorel,
 	AOTupleId  *aoTupleId;
 	int64		tupleCount = 0;
 	int64		tuplePerPage = INT_MAX;
+	int64		movedSinceDelay = 0;
 
 	Assert(Gp_role == GP_ROLE_EXECUTE || Gp_role == GP_ROLE_UTILITY);
 	Assert(RelationIsAoRows(aorel));
@@ -366,7 +407,8 @@ AppendOnlySegmentFileFullCompaction(Relation aorel,
 	compact_segno = fsinfo->segno;
 	if (fsinfo->varblockcount > 0)
 	{
-		tuplePerPage = fsinfo->total_tupcount / fsinfo->varblockcount;
+		/* less than one tuple per block if tuples span several blocks */
+		tuplePerPage = Max(fsinfo->total_tupcount / fsinfo->varblockcount, 1);
 	}
 	relname = RelationGetRelationName(aorel);
 
@@ -425,6 +467,7 @@ AppendOnlySegmentFileFullCompaction(Relation aorel,
 								resultRelInfo,
 								estate);
 			movedTupleCount++;
+			movedSinceDelay++;
 		}
 		else
 		{
@@ -440,7 +483,10 @@ AppendOnlySegmentFileFullCompaction(Relation aorel,
 		tupleCount++;
 		if (VacuumCostActive && tupleCount % tuplePerPage == 0)
 		{
-			vacuum_delay_point();
+			AppendOnlyCompaction_VacuumDelayPoint(aorel, 1,
+												  tuplePerPage,
+												  movedSinceDelay);
+			movedSinceDelay = 0;
 		}
 	}
 
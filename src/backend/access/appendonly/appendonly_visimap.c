@@ -179,6 +179,29 @@ AppendOnlyVisimap_Find(
 	}
 }
 
+/*
+ * Positions the current visimap entry so that it covers the given tuple id.
+ *
+ * Assumes that the visibility has been initialized and not finished.
+ */
+static void
+AppendOnlyVisimap_Position(
+						   AppendOnlyVisimap *visiMap,
+						   AOTupleId *aoTupleId)
+{
+	if (!AppendOnlyVisimapEntry_CoversTuple(&visiMap->visimapEntry,
+											aoTupleId))
+	{
+		/* if necessary persist the current entry before moving. */
+		if (AppendOnlyVisimapEntry_HasChanged(&visiMap->visimapEntry))
+		{
+			AppendOnlyVisimap_Store(visiMap);
+		}
+
+		AppendOnlyVisimap_Find(visiMap, aoTupleId);
+	}
+}
+
 /*
  * Checks if a tuple is visible according to the visibility map.
  * A positive result is a necessary but not sufficient condition for
@@ -198,23 +221,55 @@ AppendOnlyVisimap_IsVisible(
 		   "(tupleId) = %s",
 		   AOTupleIdToString(aoTupleId));
 
-	if (!AppendOnlyVisimapEntry_CoversTuple(&visiMap->visimapEntry,
-											aoTupleId))
-	{
-		/* if necessary persist the current entry before moving. */
-		if (AppendOnlyVisimapEntry_HasChanged(&visiMap->visimapEntry))
-		{
-			AppendOnlyVisimap_Store(visiMap);
-		}
-
-		AppendOnlyVisimap_Find(visiMap, aoTupleId);
-	}
+	AppendOnlyVisimap_Position(visiMap, aoTupleId);
 
 	/* visimap entry is now positioned to cover the aoTupleId */
 	return AppendOnlyVisimapEntry_IsVisible(&visiMap->visimapEntry,
 											aoTupleId);
 }
 
+/*
+ * Checks if all rowCount rows starting at firstRowNum in the given segment
+ * file are visible according to the visibility map.
+ *
+ * Scans call this once per block, so that the common case of a block
+ * without any deleted rows needs no per-tuple visimap lookups. If the
+ * result is false, the rows have to be checked one by one with
+ * AppendOnlyVisimap_IsVisible.
+ *
+ * Assumes that the visibility has been initialized and not finished.
+ */
+bool
+AppendOnlyVisimap_IsRangeVisible(
+								 AppendOnlyVisimap *visiMap,
+								 int segno,
+								 int64 firstRowNum,
+								 int64 rowCount)
+{
+	int64		rowNum = firstRowNum;
+	int64		lastRowNum = firstRowNum + rowCount - 1;
+
+	Assert(visiMap);
+
+	while (rowNum <= lastRowNum)
+	{
+		AOTupleId	aoTupleId;
+
+		AOTupleIdInit(&aoTupleId, segno, rowNum);
+		AppendOnlyVisimap_Position(visiMap, &aoTupleId);
+
+		if (!AppendOnlyVisimapEntry_IsRangeVisible(&visiMap->visimapEntry,
+												   rowNum, lastRowNum))
+			return false;
+
+		/* The range may continue in the next visimap entry */
+		rowNum = AppendOnlyVisimapEntry_GetFirstRowNum(&visiMap->visimapEntry,
+													   &aoTupleId) +
+			APPENDONLY_VISIMAP_MAX_RANGE;
+	}
+	return true;
+}
+
 /*
  * Stores the current visibility map entry information
  * in the relation either as update or delete.
@@ -480,6 +480,49 @@ AppendOnlyVisimapEntry_IsVisible(
 	return visibilityBit;
 }
 
+/*
+ * Checks if all rows from firstRowNum to lastRowNum (inclusive) are visible
+ * according to the bitmap.
+ *
+ * Should only be called if the current visimap entry covers firstRowNum.
+ * Rows past the end of the range covered by the entry are not checked.
+ */
+bool
+AppendOnlyVisimapEntry_IsRangeVisible(
+									  AppendOnlyVisimapEntry *visiMapEntry,
+									  int64 firstRowNum,
+									  int64 lastRowNum)
+{
+	int64		firstOffset,
+				lastOffset;
+	int			hiddenOffset;
+
+	Assert(visiMapEntry);
+	Assert(AppendOnlyVisimapEntry_IsValid(visiMapEntry));
+	Assert(firstRowNum >= visiMapEntry->firstRowNum);
+	Assert(firstRowNum <= lastRowNum);
+
+	if (AppendOnlyVisimapEntry_AreAllVisible(visiMapEntry))
+		return true;
+
+	AppendOnlyVisimapEntry_GetRownumOffset(visiMapEntry,
+										   firstRowNum, &firstOffset);
+	AppendOnlyVisimapEntry_GetRownumOffset(visiMapEntry,
+										   lastRowNum, &lastOffset);
+	lastOffset = Min(lastOffset, APPENDONLY_VISIMAP_MAX_RANGE - 1);
+
+	/* Find the first hidden row at or after the start of the range */
+	hiddenOffset = bms_next_member(visiMapEntry->bitmap, (int) firstOffset - 1);
+
+	elogif(Debug_appendonly_print_visimap, LOG,
+		   "Append-only visi map entry: Check range visibility: "
+		   "(firstRowNum, lastRowNum, firstHiddenOffset) = "
+		   "(" INT64_FORMAT ", " INT64_FORMAT ", %d)",
+		   firstRowNum, lastRowNum, hiddenOffset);
+
+	return hiddenOffset < 0 || hiddenOffset > lastOffset;
+}
+
 /*
  * The minimal size (in uint32's elements) the entry array needs to have to
  * cover the given offset
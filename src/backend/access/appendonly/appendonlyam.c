@@ -1278,6 +1278,17 @@ getNextBlock(AppendOnlyScanDesc scan)
 											 false);
 	}
 
+	/*
+	 * Check the visibility of all the rows in the block at once. Blocks
+	 * without deleted rows then need no visimap lookup per tuple.
+	 */
+	if (scan->snapshot != SnapshotAny)
+		scan->blockAllVisible =
+			AppendOnlyVisimap_IsRangeVisible(&scan->visibilityMap,
+											 scan->executorReadBlock.segmentFileNum,
+											 scan->executorReadBlock.blockFirstRowNum,
+											 scan->executorReadBlock.rowCount);
+
 	AppendOnlyExecutorReadBlock_GetContents(
 											&scan->executorReadBlock);
 
@@ -1341,7 +1352,8 @@ appendonlygettup(AppendOnlyScanDesc scan,
 			 */
 			AOTupleId  *aoTupleId = (AOTupleId *) slot_get_ctid(slot);
 
-			if (!isSnapshotAny && !AppendOnlyVisimap_IsVisible(&scan->visibilityMap, aoTupleId))
+			if (!isSnapshotAny && !scan->blockAllVisible &&
+				!AppendOnlyVisimap_IsVisible(&scan->visibilityMap, aoTupleId))
 			{
 				/*
 				 * The tuple is invisible.
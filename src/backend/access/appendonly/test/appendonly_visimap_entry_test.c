@@ -70,6 +70,51 @@ test__AppendOnlyVisimapEntry_CoversTuple(void **state)
 	assert_true(result);
 }
 
+static void
+test__AppendOnlyVisimapEntry_IsRangeVisible(void **state)
+{
+	bool result;
+	AppendOnlyVisimapEntry visiMapEntry;
+	Bitmapset	fake_bitmap;
+	Bitmapset  *bitmap = &fake_bitmap;
+
+	visiMapEntry.segmentFileNum = 1;
+	visiMapEntry.firstRowNum = 32768;
+	visiMapEntry.bitmap = bitmap;
+
+	/* Nothing hidden in the entry at all. */
+	expect_value(bms_is_empty, a, bitmap);
+	will_return(bms_is_empty, true);
+	result = AppendOnlyVisimapEntry_IsRangeVisible(&visiMapEntry, 32768, 32868);
+	assert_true(result);
+
+	/* First hidden row (offset 100) is past the end of the range. */
+	expect_value(bms_is_empty, a, bitmap);
+	will_return(bms_is_empty, false);
+	expect_value(bms_next_member, a, bitmap);
+	expect_value(bms_next_member, prevbit, 9);
+	will_return(bms_next_member, 100);
+	result = AppendOnlyVisimapEntry_IsRangeVisible(&visiMapEntry, 32778, 32867);
+	assert_true(result);
+
+	/* Hidden row at the last row of the range. */
+	expect_value(bms_is_empty, a, bitmap);
+	will_return(bms_is_empty, false);
+	expect_value(bms_next_member, a, bitmap);
+	expect_value(bms_next_member, prevbit, 9);
+	will_return(bms_next_member, 100);
+	result = AppendOnlyVisimapEntry_IsRangeVisible(&visiMapEntry, 32778, 32868);
+	assert_false(result);
+
+	/* No hidden row after the start of the range. */
+	expect_value(bms_is_empty, a, bitmap);
+	will_return(bms_is_empty, false);
+	expect_value(bms_next_member, a, bitmap);
+	expect_value(bms_next_member, prevbit, 100);
+	will_return(bms_next_member, -2);
+	result = AppendOnlyVisimapEntry_IsRangeVisible(&visiMapEntry, 32869, 70000);
+	assert_true(result);
+}
 
 int
 main(int argc, char *argv[])
@@ -78,7 +123,8 @@ main(int argc, char *argv[])
 
 	const		UnitTest tests[] = {
 		unit_test(test__AppendOnlyVisimapEntry_GetFirstRowNum),
-		unit_test(test__AppendOnlyVisimapEntry_CoversTuple)
+		unit_test(test__AppendOnlyVisimapEntry_CoversTuple),
+		unit_test(test__AppendOnlyVisimapEntry_IsRangeVisible)
 	};
 
 	MemoryContextInit();
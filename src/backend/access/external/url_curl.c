@@ -109,6 +109,15 @@ typedef struct
 #define FDIST_TIMEOUT  408
 #define MAX_TRY_WAIT_TIME 64
 
+/*
+ * fill_buffer() keeps reading data that has already arrived, until this
+ * much is buffered, even when the caller asked for less.
+ */
+#define CURL_PREFETCH_SIZE (1024 * 1024)
+
+/* size of the buffer libcurl receives data into */
+#define CURL_RECV_BUFFER_SIZE (256 * 1024)
+
 /*
  * SSL support GUCs - should be added soon. Until then we will use stubs
  *
@@ -747,6 +756,25 @@ fill_buffer(URL_CURL_FILE *curl, int want)
 		*/
 	}
 
+	/*
+	 * Also take in whatever data has already arrived on the socket, without
+	 * waiting for more, so that it is at hand when the caller is done with
+	 * the current block. Otherwise the data would sit in the socket's
+	 * receive buffer while we parse, and once that is full, the server has
+	 * to stop sending, which hurts a lot on high-latency links.
+	 */
+	if (curl->still_running && curl->in.top - curl->in.bot < CURL_PREFETCH_SIZE)
+	{
+		while (CURLM_CALL_MULTI_PERFORM ==
+			   (e = curl_multi_perform(multi_handle, &curl->still_running)));
+
+		if (e != 0)
+		{
+			elog(ERROR, "internal error: curl_multi_perform failed (%d - %s)",
+				 e, curl_easy_strerror(e));
+		}
+	}
+
 	if (curl->still_running == 0)
 	{
 		elog(LOG, "quit fill_buffer due to still_running = 0, bot = %d, top = %d, want = %d, "
@@ -1138,6 +1166,11 @@ url_curl_fopen(char *url, bool forwrite, extvar_t *ev, CopyState pstate)
 	/* 'file' is the application variable that gets passed to write_callback */
 	CURL_EASY_SETOPT(file->curl->handle, CURLOPT_WRITEDATA, file);
 
+#ifdef CURL_MAX_READ_SIZE
+	/* receive data in large chunks; older libcurls can't go above 16 kB */
+	CURL_EASY_SETOPT(file->curl->handle, CURLOPT_BUFFERSIZE, (long) CURL_RECV_BUFFER_SIZE);
+#endif
+
 	if ( !is_ipv6 )
 		ip_mode = CURL_IPRESOLVE_V4;
 	else
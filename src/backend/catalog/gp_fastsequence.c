@@ -295,6 +295,56 @@ int64 GetFastSequences(Oid objid, int64 objmod,
 	return firstSequence;
 }
 
+/*
+ * ReadLastSequence
+ *
+ * Return the current lastsequence value for the given object, without
+ * allocating any new sequence numbers. Returns 0 if there is no entry.
+ *
+ * For an append-only segment file, every row number handed out so far
+ * is less than or equal to the returned value.
+ */
+int64
+ReadLastSequence(Oid objid, int64 objmod)
+{
+	Relation	gp_fastsequence_rel;
+	ScanKeyData scankey[2];
+	SysScanDesc scan;
+	HeapTuple	tuple;
+	int64		lastSequence = 0;
+
+	gp_fastsequence_rel = heap_open(FastSequenceRelationId, AccessShareLock);
+
+	ScanKeyInit(&scankey[0],
+				Anum_gp_fastsequence_objid,
+				BTEqualStrategyNumber, F_OIDEQ,
+				ObjectIdGetDatum(objid));
+	ScanKeyInit(&scankey[1],
+				Anum_gp_fastsequence_objmod,
+				BTEqualStrategyNumber, F_INT8EQ,
+				Int64GetDatum(objmod));
+	scan = systable_beginscan(gp_fastsequence_rel, FastSequenceObjidObjmodIndexId, true,
+							  NULL, 2, scankey);
+
+	tuple = systable_getnext(scan);
+	if (HeapTupleIsValid(tuple))
+	{
+		Datum		lastSequenceDatum;
+		bool		isNull;
+
+		lastSequenceDatum = heap_getattr(tuple, Anum_gp_fastsequence_last_sequence,
+										 RelationGetDescr(gp_fastsequence_rel),
+										 &isNull);
+		if (!isNull)
+			lastSequence = DatumGetInt64(lastSequenceDatum);
+	}
+
+	systable_endscan(scan);
+	heap_close(gp_fastsequence_rel, AccessShareLock);
+
+	return lastSequence;
+}
+
 /*
  * RemoveFastSequenceEntry
  *
@@ -837,6 +837,9 @@ CREATE VIEW gp_stat_replication AS
          ON G.gp_segment_id = R.gp_segment_id
     );
 
+CREATE VIEW gp_idle_qe_pool_stats AS
+    SELECT * FROM pg_catalog.gp_get_idle_qe_pool_stats();
+
 CREATE VIEW pg_stat_wal_receiver AS
     SELECT
             s.pid,
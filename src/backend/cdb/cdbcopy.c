@@ -38,6 +38,8 @@
  *
  * cdbCopyGetData() and cdbCopySendData() call libpq's PQgetCopyData() and
  * PQputCopyData(), respectively. If an error occurs, it is thrown with ereport().
+ * cdbCopySendData() collects the data for each segment in a buffer, and only
+ * passes it to libpq once there is a sizable chunk of it, or at cdbCopyEnd().
  *
  * When you're done, call cdbCopyEnd().
  *
@@ -77,6 +79,7 @@
 static void cdbCopyEndInternal(CdbCopy *c, char *abort_msg,
 				   int64 *total_rows_completed_p,
 				   int64 *total_rows_rejected_p);
+static void cdbCopyFlushData(CdbCopy *c, int target_seg);
 
 static Gang *
 getCdbCopyPrimaryGang(CdbCopy *c)
@@ -107,6 +110,8 @@ makeCdbCopy(CopyState cstate, bool is_copy_in)
 	c->copy_in = is_copy_in;
 	c->seglist = NIL;
 	c->dispatcherState = NULL;
+	c->segdbs = NULL;
+	c->copy_in_bufs = NULL;
 	initStringInfo(&(c->copy_out_buf));
 
 	/* init total_segs */
@@ -209,6 +214,24 @@ cdbCopyStart(CdbCopy *c, CopyStmt *stmt,
 
 	CdbDispatchCopyStart(c, (Node *) stmt, flags);
 
+	if (c->copy_in)
+	{
+		Gang	   *gp = getCdbCopyPrimaryGang(c);
+		int			i;
+
+		c->segdbs = palloc0(c->total_segs * sizeof(SegmentDatabaseDescriptor *));
+		c->copy_in_bufs = palloc0(c->total_segs * sizeof(StringInfoData));
+
+		for (i = 0; i < gp->size; i++)
+		{
+			SegmentDatabaseDescriptor *q = gp->db_descriptors[i];
+
+			Assert(q->segindex >= 0 && q->segindex < c->total_segs);
+			c->segdbs[q->segindex] = q;
+			initStringInfo(&c->copy_in_bufs[q->segindex]);
+		}
+	}
+
 	SIMPLE_FAULT_INJECTOR("cdb_copy_start_after_dispatch");
 }
 
@@ -233,26 +256,48 @@ cdbCopySendDataToAll(CdbCopy *c, const char *buffer, int nbytes)
 /*
  * sends data to a copy command on a specific segment (usually
  * the hash result of the data value).
+ *
+ * The data is only collected in the segment's buffer here; it is handed
+ * to libpq once there is COPYIN_CHUNK_SIZE of it.
  */
 void
 cdbCopySendData(CdbCopy *c, int target_seg, const char *buffer,
 				int nbytes)
 {
-	SegmentDatabaseDescriptor *q;
-	Gang	   *gp;
+	StringInfo	buf;
+
+	if (target_seg < 0 || target_seg >= c->total_segs ||
+		c->segdbs[target_seg] == NULL)
+		elog(ERROR, "could not send COPY data to segment %d, segment not in COPY",
+			 target_seg);
+
+	buf = &c->copy_in_bufs[target_seg];
+	appendBinaryStringInfo(buf, buffer, nbytes);
+
+	if (buf->len >= COPYIN_CHUNK_SIZE)
+		cdbCopyFlushData(c, target_seg);
+}
+
+/*
+ * passes the data collected for a segment to libpq.
+ */
+static void
+cdbCopyFlushData(CdbCopy *c, int target_seg)
+{
+	SegmentDatabaseDescriptor *q = c->segdbs[target_seg];
+	StringInfo	buf = &c->copy_in_bufs[target_seg];
 	int			result;
 
+	if (buf->len == 0)
+		return;
+
 	/*
 	 * NOTE!! note that another DELIM was added, for the buf_converted in the
 	 * code above. I didn't do it because it's broken right now
 	 */
 
-	gp = getCdbCopyPrimaryGang(c);
-	Assert(gp);
-	q = getSegmentDescriptorFromGang(gp, target_seg);
-
 	/* transmit the COPY data */
-	result = PQputCopyData(q->conn, buffer, nbytes);
+	result = PQputCopyData(q->conn, buf->data, buf->len);
 
 	if (result != 1)
 	{
@@ -270,6 +315,8 @@ cdbCopySendData(CdbCopy *c, int target_seg, const char *buffer,
 					 errmsg("could not send COPY data to segment %d: %s",
 							target_seg, PQerrorMessage(q->conn))));
 	}
+
+	resetStringInfo(buf);
 }
 
 /*
@@ -468,10 +515,21 @@ cdbCopyEndInternal(CdbCopy *c, char *abort_msg,
 	}
 
 	/*
-	 * In COPY in mode, call PQputCopyEnd() to tell the segments that we're done.
+	 * In COPY in mode, send any data still in our buffers, unless we are
+	 * aborting anyway, and call PQputCopyEnd() to tell the segments that
+	 * we're done.
 	 */
 	if (c->copy_in)
 	{
+		if (abort_msg == NULL && c->segdbs != NULL)
+		{
+			for (seg = 0; seg < c->total_segs; seg++)
+			{
+				if (c->segdbs[seg] != NULL)
+					cdbCopyFlushData(c, seg);
+			}
+		}
+
 		for (seg = 0; seg < gp->size; seg++)
 		{
 			SegmentDatabaseDescriptor *q = gp->db_descriptors[seg];
@@ -643,6 +701,9 @@ cdbCopyEndInternal(CdbCopy *c, char *abort_msg,
 		}
 		RESUME_INTERRUPTS();
 
+		/* Remember whether this segment needs to take part in two-phase commit */
+		markCurrentGxactSegmentStatus(q);
+
 		/*
 		 * add up the number of rows completed and rejected from this segment
 		 * to the totals. Only count from primary segs.
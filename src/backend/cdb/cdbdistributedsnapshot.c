@@ -23,6 +23,12 @@
 #include "utils/snapmgr.h"
 #include "storage/procarray.h"
 
+static bool DistributedSnapshot_XidInProgress(DistributedSnapshot *ds,
+								  DistributedTransactionId distribXid);
+static int	varint_size(uint32 val);
+static char *varint_put(char *p, uint32 val);
+static const char *varint_get(const char *p, uint32 *val);
+
 /*
  * DistributedSnapshotWithLocalMapping_CommittedTest
  *		Is the given XID still-in-progress according to the
@@ -178,45 +184,33 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 		return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
 	}
 
-	for (i = 0; i < ds->count; i++)
+	if (DistributedSnapshot_XidInProgress(ds, distribXid))
 	{
-		if (distribXid == ds->inProgressXidArray[i])
+		/*
+		 * Save the relationship to the local xid so we may avoid checking
+		 * the distributed committed log in a subsequent check. We can only
+		 * record local xids till cache size permits.
+		 */
+		if (dslm->currentLocalXidsCount < ds->count)
 		{
-			/*
-			 * Save the relationship to the local xid so we may avoid checking
-			 * the distributed committed log in a subsequent check. We can
-			 * only record local xids till cache size permits.
-			 */
-			if (dslm->currentLocalXidsCount < ds->count)
+			Assert(dslm->inProgressMappedLocalXids != NULL);
+			dslm->inProgressMappedLocalXids[dslm->currentLocalXidsCount++] =
+				localXid;
+
+			if (!TransactionIdIsValid(dslm->minCachedLocalXid) ||
+				TransactionIdPrecedes(localXid, dslm->minCachedLocalXid))
 			{
-				Assert(dslm->inProgressMappedLocalXids != NULL);
-				dslm->inProgressMappedLocalXids[dslm->currentLocalXidsCount++] =
-					localXid;
-
-				if (!TransactionIdIsValid(dslm->minCachedLocalXid) ||
-					TransactionIdPrecedes(localXid, dslm->minCachedLocalXid))
-				{
-					dslm->minCachedLocalXid = localXid;
-				}
-
-				if (!TransactionIdIsValid(dslm->maxCachedLocalXid) ||
-					TransactionIdFollows(localXid, dslm->maxCachedLocalXid))
-				{
-					dslm->maxCachedLocalXid = localXid;
-				}
+				dslm->minCachedLocalXid = localXid;
 			}
 
-			return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
+			if (!TransactionIdIsValid(dslm->maxCachedLocalXid) ||
+				TransactionIdFollows(localXid, dslm->maxCachedLocalXid))
+			{
+				dslm->maxCachedLocalXid = localXid;
+			}
 		}
 
-		/*
-		 * Leverage the fact that ds->inProgressXidArray is sorted in
-		 * ascending order based on distribXid while creating the snapshot in
-		 * CreateDistributedSnapshot(). So, can fail fast once known are
-		 * lower than rest of them.
-		 */
-		if (distribXid < ds->inProgressXidArray[i])
-			break;
+		return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
 	}
 
 	/*
@@ -225,6 +219,37 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 	return DISTRIBUTEDSNAPSHOT_COMMITTED_VISIBLE;
 }
 
+/*
+ * Is distribXid in the snapshot's in-progress array?
+ *
+ * ds->inProgressXidArray is sorted in ascending order based on distribXid
+ * while creating the snapshot in CreateDistributedSnapshot(), so we can
+ * binary search it.  This matters with many concurrent transactions, as
+ * we get here for every tuple whose distributed transaction committed.
+ */
+static bool
+DistributedSnapshot_XidInProgress(DistributedSnapshot *ds,
+								  DistributedTransactionId distribXid)
+{
+	int32		low = 0;
+	int32		high = ds->count - 1;
+
+	while (low <= high)
+	{
+		int32		mid = low + (high - low) / 2;
+		DistributedTransactionId xid = ds->inProgressXidArray[mid];
+
+		if (distribXid == xid)
+			return true;
+		if (distribXid < xid)
+			high = mid - 1;
+		else
+			low = mid + 1;
+	}
+
+	return false;
+}
+
 /*
  * Reset all fields except maxCount and the malloc'd pointer for
  * inProgressXidArray.
@@ -297,23 +322,90 @@ DistributedSnapshot_Copy(DistributedSnapshot *target,
 			source->count * sizeof(DistributedTransactionId));
 }
 
+/*
+ * The in-progress array is serialized as a sequence of deltas: the first xid
+ * relative to xmin, and each following one relative to its predecessor.  The
+ * array is sorted, and the xids of concurrent transactions are usually close
+ * together, so most deltas fit in one byte rather than four.  This keeps the
+ * snapshot that is dispatched with every query small even with thousands of
+ * transactions in progress.
+ *
+ * Each delta is stored 7 bits at a time, least significant group first, with
+ * the high bit set in every byte but the last.
+ */
+static int
+varint_size(uint32 val)
+{
+	int			size = 1;
+
+	while (val >= 0x80)
+	{
+		val >>= 7;
+		size++;
+	}
+	return size;
+}
+
+static char *
+varint_put(char *p, uint32 val)
+{
+	while (val >= 0x80)
+	{
+		*p++ = (char) ((val & 0x7F) | 0x80);
+		val >>= 7;
+	}
+	*p++ = (char) val;
+	return p;
+}
+
+static const char *
+varint_get(const char *p, uint32 *val)
+{
+	uint32		result = 0;
+	int			shift = 0;
+	uint8		byte;
+
+	do
+	{
+		byte = (uint8) *p++;
+		result |= (uint32) (byte & 0x7F) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+
+	*val = result;
+	return p;
+}
+
 int
 DistributedSnapshot_SerializeSize(DistributedSnapshot *ds)
 {
-	return sizeof(DistributedTransactionTimeStamp) +
+	DistributedTransactionId prev = ds->xmin;
+	int			size;
+	int			i;
+
+	size = sizeof(DistributedTransactionTimeStamp) +
 		sizeof(DistributedSnapshotId) +
 	/* xminAllDistributedSnapshots, xmin, xmax */
 		3 * sizeof(DistributedTransactionId) +
 	/* count */
-		sizeof(int32) +
-	/* Size of inProgressXidArray */
-		sizeof(DistributedTransactionId) * ds->count;
+		sizeof(int32);
+
+	/* Size of the delta-encoded inProgressXidArray */
+	for (i = 0; i < ds->count; i++)
+	{
+		size += varint_size(ds->inProgressXidArray[i] - prev);
+		prev = ds->inProgressXidArray[i];
+	}
+
+	return size;
 }
 
 int
 DistributedSnapshot_Serialize(DistributedSnapshot *ds, char *buf)
 {
 	char	   *p = buf;
+	DistributedTransactionId prev;
+	int			i;
 
 	memcpy(p, &ds->distribTransactionTimeStamp, sizeof(DistributedTransactionTimeStamp));
 	p += sizeof(DistributedTransactionTimeStamp);
@@ -328,8 +420,12 @@ DistributedSnapshot_Serialize(DistributedSnapshot *ds, char *buf)
 	memcpy(p, &ds->count, sizeof(int32));
 	p += sizeof(int32);
 
-	memcpy(p, ds->inProgressXidArray, sizeof(DistributedTransactionId) * ds->count);
-	p += sizeof(DistributedTransactionId) * ds->count;
+	prev = ds->xmin;
+	for (i = 0; i < ds->count; i++)
+	{
+		p = varint_put(p, ds->inProgressXidArray[i] - prev);
+		prev = ds->inProgressXidArray[i];
+	}
 
 	Assert((p - buf) == DistributedSnapshot_SerializeSize(ds));
 
@@ -356,7 +452,8 @@ DistributedSnapshot_Deserialize(const char *buf, DistributedSnapshot *ds)
 
 	if (ds->count > 0)
 	{
-		int xipsize = sizeof(DistributedTransactionId) * ds->count;
+		DistributedTransactionId prev = ds->xmin;
+		int			i;
 
 		if (ds->inProgressXidArray == NULL)
 		{
@@ -368,8 +465,14 @@ DistributedSnapshot_Deserialize(const char *buf, DistributedSnapshot *ds)
 						 errmsg("out of memory")));
 		}
 
-		memcpy(ds->inProgressXidArray, p, xipsize);
-		p += xipsize;
+		for (i = 0; i < ds->count; i++)
+		{
+			uint32		delta;
+
+			p = varint_get(p, &delta);
+			prev += delta;
+			ds->inProgressXidArray[i] = prev;
+		}
 	}
 
 	Assert((p - buf) == DistributedSnapshot_SerializeSize(ds));
@@ -124,6 +124,7 @@ static void setCurrentDtxState(DtxState state);
 static bool isDtxQueryDispatcher(void);
 static void performDtxProtocolCommitPrepared(const char *gid, bool raiseErrorIfNotFound);
 static void performDtxProtocolAbortPrepared(const char *gid, bool raiseErrorIfNotFound);
+static int countGxactSegmentsWithXid(void);
 
 extern void CheckForResetSession(void);
 
@@ -784,13 +785,15 @@ prepareDtxTransaction(void)
 	}
 
 	/*
-	 * If only one segment was involved in the transaction, and no local XID
-	 * has been assigned on the QD either, we can perform one-phase commit
-	 * on that one segment. Otherwise, broadcast PREPARE TRANSACTION to the
-	 * segments.
+	 * If at most one segment has an XID in the transaction, and no local XID
+	 * has been assigned on the QD either, we can perform one-phase commit.
+	 * The other segments involved were only read from, so there is nothing
+	 * for their commit to be atomic with, and we save the PREPARE round trip
+	 * and its WAL flush on every segment.  Otherwise, broadcast PREPARE
+	 * TRANSACTION to the segments.
 	 */
 	if (!ExecutorDidWriteXLog() ||
-		(!markXidCommitted && list_length(MyTmGxactLocal->dtxSegments) < 2))
+		(!markXidCommitted && countGxactSegmentsWithXid() < 2))
 	{
 		setCurrentDtxState(DTX_STATE_ONE_PHASE_COMMIT);
 		return;
@@ -1285,6 +1288,8 @@ resetGxact(void)
 	MyTmGxactLocal->writerGangLost = false;
 	MyTmGxactLocal->dtxSegmentsMap = NULL;
 	MyTmGxactLocal->dtxSegments = NIL;
+	MyTmGxactLocal->reportedSegmentsMap = NULL;
+	MyTmGxactLocal->xidSegmentsMap = NULL;
 	MyTmGxactLocal->isOnePhaseCommit = false;
 	setCurrentDtxState(DTX_STATE_NONE);
 }
@@ -2231,6 +2236,56 @@ addToGxactDtxSegments(Gang *gang)
 	MemoryContextSwitchTo(oldContext);
 }
 
+/*
+ * Record the transaction status a QE reported along with its command
+ * results: whether it has written XLOG, and whether it has been assigned a
+ * top-level XID.  Only writer QEs get an XID, so the latter is only
+ * remembered for them.
+ */
+void
+markCurrentGxactSegmentStatus(struct SegmentDatabaseDescriptor *segdbDesc)
+{
+	MemoryContext oldContext;
+	int			segindex = segdbDesc->segindex;
+
+	if (segdbDesc->conn->wrote_xlog)
+		MarkCurrentTransactionWriteXLogOnExecutor();
+
+	if (!isCurrentDtxActivated() || segindex < 0 || !segdbDesc->isWriter)
+		return;
+
+	oldContext = MemoryContextSwitchTo(TopTransactionContext);
+	MyTmGxactLocal->reportedSegmentsMap =
+		bms_add_member(MyTmGxactLocal->reportedSegmentsMap, segindex);
+	if (segdbDesc->conn->has_top_xid)
+		MyTmGxactLocal->xidSegmentsMap =
+			bms_add_member(MyTmGxactLocal->xidSegmentsMap, segindex);
+	MemoryContextSwitchTo(oldContext);
+}
+
+/*
+ * Count the segments in the transaction that may have something to commit:
+ * those whose writer QE reported a top-level XID, and, since we cannot tell
+ * otherwise, those whose writer QE did not report its status at all.
+ */
+static int
+countGxactSegmentsWithXid(void)
+{
+	ListCell   *lc;
+	int			count = 0;
+
+	foreach(lc, MyTmGxactLocal->dtxSegments)
+	{
+		int			segindex = lfirst_int(lc);
+
+		if (bms_is_member(segindex, MyTmGxactLocal->xidSegmentsMap) ||
+			!bms_is_member(segindex, MyTmGxactLocal->reportedSegmentsMap))
+			count++;
+	}
+
+	return count;
+}
+
 bool
 CurrentDtxIsRollingback(void)
 {
@@ -24,7 +24,9 @@
 
 #include <sys/param.h>			/* for MAXHOSTNAMELEN */
 #include "access/genam.h"
+#include "access/htup_details.h"
 #include "catalog/gp_segment_config.h"
+#include "funcapi.h"
 #include "nodes/makefuncs.h"
 #include "utils/builtins.h"
 #include "utils/fmgroids.h"
@@ -71,6 +73,14 @@
 MemoryContext CdbComponentsContext = NULL;
 static CdbComponentDatabases *cdb_component_dbs = NULL;
 
+/*
+ * How many times cdbcomponent_allocateIdleQE() found an idle QE in the
+ * freelist, and how many times it had to set up a new one.  These count
+ * for the whole session, and survive cdbcomponent_destroyCdbComponents().
+ */
+static int64 numIdleQEHits = 0;
+static int64 numIdleQEMisses = 0;
+
 /*
  * Helper Functions
  */
@@ -801,7 +811,10 @@ cdbcomponent_allocateIdleQE(int contentId, SegmentType segmentType)
 		 */
 		isWriter = contentId == -1 ? false: (cdbinfo->numIdleQEs == 0 && cdbinfo->numActiveQEs == 0);
 		segdbDesc = cdbconn_createSegmentDescriptor(cdbinfo, nextQEIdentifer(cdbinfo->cdbs), isWriter);
+		numIdleQEMisses++;
 	}
+	else
+		numIdleQEHits++;
 
 	cdbconn_setQEIdentifier(segdbDesc, -1);
 
@@ -955,6 +968,43 @@ cdbcomponent_activeQEsExist(void)
 	return !cdb_component_dbs ? false : cdb_component_dbs->numActiveQEs > 0;
 }
 
+/*
+ * Report how many QEs this session has taken from the idle QE freelists
+ * (hits), and how many it had to connect anew (misses).
+ */
+void
+cdbcomponent_getIdleQEStats(int64 *hits, int64 *misses)
+{
+	*hits = numIdleQEHits;
+	*misses = numIdleQEMisses;
+}
+
+/*
+ * gp_get_idle_qe_pool_stats - SQL-callable wrapper around
+ * cdbcomponent_getIdleQEStats(), used by the gp_idle_qe_pool_stats view.
+ */
+Datum
+gp_get_idle_qe_pool_stats(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Datum		values[2];
+	bool		nulls[2];
+	int64		hits;
+	int64		misses;
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	cdbcomponent_getIdleQEStats(&hits, &misses);
+
+	MemSet(nulls, 0, sizeof(nulls));
+	values[0] = Int64GetDatum(hits);
+	values[1] = Int64GetDatum(misses);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(BlessTupleDesc(tupdesc),
+													  values, nulls)));
+}
+
 /*
  * Find CdbComponentDatabaseInfo in the array by segment index.
  */
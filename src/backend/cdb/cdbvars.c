@@ -294,6 +294,7 @@ char	   *gp_autostats_mode_string;
 int			gp_autostats_mode_in_functions;
 char	   *gp_autostats_mode_in_functions_string;
 int			gp_autostats_on_change_threshold = 100000;
+double		gp_autostats_on_change_scale_factor = 0;
 bool		log_autostats = true;
 
 /* --------------------------------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 #include "cdb/cdbgang.h"
 #include "cdb/cdbvars.h"
 #include "cdb/cdbpq.h"
+#include "cdb/cdbtm.h"
 #include "miscadmin.h"
 #include "commands/sequence.h"
 #include "access/xact.h"
@@ -185,65 +186,85 @@ cdbdisp_getWaitSocketFd_async(struct CdbDispatcherState *ds)
 
 /*
  * Block until all data are dispatched.
+ *
+ * The query text is shared by all QEs, so with many segments most of the
+ * time here is spent waiting for socket buffers to drain.  Keep a compact
+ * array of the connections that still have unsent data, and only try to
+ * push more data to the ones that poll() reported as writable, rather than
+ * calling send() on every connection after every wakeup.
  */
 static void
 cdbdisp_waitDispatchFinish_async(struct CdbDispatcherState *ds)
 {
 	const static int DISPATCH_POLL_TIMEOUT = 500;
 	struct pollfd *fds;
+	CdbDispatchResult **pending;
 	int			nfds,
 				i;
 	CdbDispatchCmdAsync *pParms = (CdbDispatchCmdAsync *) ds->dispatchParams;
 	int			dispatchCount = pParms->dispatchCount;
 
 	fds = (struct pollfd *) palloc(dispatchCount * sizeof(struct pollfd));
+	pending = (CdbDispatchResult **) palloc(dispatchCount * sizeof(CdbDispatchResult *));
 
-	while (true)
+	/*
+	 * Collect the connections that still have unsent data. Mark them all as
+	 * writable for the first pass, because they may be writable NOW.
+	 */
+	nfds = 0;
+	for (i = 0; i < dispatchCount; i++)
 	{
-		int			pollRet;
+		CdbDispatchResult *qeResult = pParms->dispatchResultPtrArray[i];
+		PGconn	   *conn = qeResult->segdbDesc->conn;
 
-		nfds = 0;
-		memset(fds, 0, dispatchCount * sizeof(struct pollfd));
+		/* skip already completed connections */
+		if (conn->outCount == 0)
+			continue;
 
-		for (i = 0; i < dispatchCount; i++)
-		{
-			CdbDispatchResult *qeResult = pParms->dispatchResultPtrArray[i];
-			SegmentDatabaseDescriptor *segdbDesc = qeResult->segdbDesc;
-			PGconn	   *conn = segdbDesc->conn;
-			int			ret;
+		pending[nfds] = qeResult;
+		fds[nfds].fd = PQsocket(conn);
+		fds[nfds].events = POLLOUT;
+		fds[nfds].revents = POLLOUT;
+		Assert(fds[nfds].fd >= 0);
+		nfds++;
+	}
 
-			/* skip already completed connections */
-			if (conn->outCount == 0)
-				continue;
+	while (nfds > 0)
+	{
+		int			pollRet;
+		int			nleft = 0;
 
-			/*
-			 * call send for this connection regardless of its POLLOUT status,
-			 * because it may be writable NOW
-			 */
-			ret = pqFlushNonBlocking(conn);
+		for (i = 0; i < nfds; i++)
+		{
+			CdbDispatchResult *qeResult = pending[i];
+			PGconn	   *conn = qeResult->segdbDesc->conn;
 
-			if (ret == 0)
-				continue;
-			else if (ret > 0)
+			if (fds[i].revents != 0)
 			{
-				int			sock = PQsocket(segdbDesc->conn);
+				int			ret = pqFlushNonBlocking(conn);
 
-				Assert(sock >= 0);
-				fds[nfds].fd = sock;
-				fds[nfds].events = POLLOUT;
-				nfds++;
-			}
-			else if (ret < 0)
-			{
-				pqHandleSendFailure(conn);
-				char	   *msg = PQerrorMessage(conn);
+				if (ret == 0)
+					continue;
+				else if (ret < 0)
+				{
+					pqHandleSendFailure(conn);
+					char	   *msg = PQerrorMessage(conn);
 
-				qeResult->stillRunning = false;
-				ereport(ERROR,
-						(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
-						 errmsg("Command could not be dispatch to segment %s: %s", qeResult->segdbDesc->whoami, msg ? msg : "unknown error")));
+					qeResult->stillRunning = false;
+					ereport(ERROR,
+							(errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+							 errmsg("Command could not be dispatch to segment %s: %s", qeResult->segdbDesc->whoami, msg ? msg : "unknown error")));
+				}
 			}
+
+			/* still has data to send, keep it in the poll set */
+			pending[nleft] = qeResult;
+			fds[nleft].fd = fds[i].fd;
+			fds[nleft].events = POLLOUT;
+			fds[nleft].revents = 0;
+			nleft++;
 		}
+		nfds = nleft;
 
 		if (nfds == 0)
 			break;
@@ -263,6 +284,7 @@ cdbdisp_waitDispatchFinish_async(struct CdbDispatcherState *ds)
 			elog(ERROR, "Poll failed during dispatch");
 	}
 
+	pfree(pending);
 	pfree(fds);
 }
 
@@ -906,8 +928,7 @@ processResults(CdbDispatchResult *dispatchResult)
 			return true;
 		}
 
-		if (segdbDesc->conn->wrote_xlog)
-			MarkCurrentTransactionWriteXLogOnExecutor();
+		markCurrentGxactSegmentStatus(segdbDesc);
 
 		/*
 		 * Attach the PGresult object to the CdbDispatchResult object.
@@ -192,10 +192,16 @@ CdbDispatchPlan(struct QueryDesc *queryDesc,
 		is_SRI = IsA(stmt->planTree, Result) &&stmt->planTree->lefttree == NULL;
 	}
 
-	if (queryDesc->operation == CMD_INSERT ||
-		queryDesc->operation == CMD_SELECT ||
-		queryDesc->operation == CMD_UPDATE ||
-		queryDesc->operation == CMD_DELETE)
+	/*
+	 * If we have already dispatched this plan tree for an earlier initPlan of
+	 * the same query, the functions have been evaluated already, and the
+	 * serialized plan can be reused as is.
+	 */
+	if (stmt != queryDesc->dispatchedStmt &&
+		(queryDesc->operation == CMD_INSERT ||
+		 queryDesc->operation == CMD_SELECT ||
+		 queryDesc->operation == CMD_UPDATE ||
+		 queryDesc->operation == CMD_DELETE))
 	{
 		List	   *cursors;
 
@@ -581,25 +587,40 @@ cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc,
 	 * serialized plan tree. Note that we're called for a single slice tree
 	 * (corresponding to an initPlan or the main plan), so the parameters are
 	 * fixed and we can include them in the prefix.
+	 *
+	 * The plan tree itself is the same for all the slice trees of a query,
+	 * so serialize it only the first time, and reuse it for the rest.
 	 */
-	splan = serializeNode((Node *) queryDesc->plannedstmt, &splan_len, &splan_len_uncompressed);
+	if (queryDesc->plannedstmt == queryDesc->dispatchedStmt)
+	{
+		splan = queryDesc->serializedPlan;
+		splan_len = queryDesc->serializedPlanLen;
+	}
+	else
+	{
+		splan = serializeNode((Node *) queryDesc->plannedstmt, &splan_len, &splan_len_uncompressed);
 
-	uint64		plan_size_in_kb = ((uint64) splan_len_uncompressed) / (uint64) 1024;
+		uint64		plan_size_in_kb = ((uint64) splan_len_uncompressed) / (uint64) 1024;
 
-	elog(((gp_log_gang >= GPVARS_VERBOSITY_TERSE) ? LOG : DEBUG1),
-		 "Query plan size to dispatch: " UINT64_FORMAT "KB", plan_size_in_kb);
+		elog(((gp_log_gang >= GPVARS_VERBOSITY_TERSE) ? LOG : DEBUG1),
+			 "Query plan size to dispatch: " UINT64_FORMAT "KB", plan_size_in_kb);
 
-	if (0 < gp_max_plan_size && plan_size_in_kb > gp_max_plan_size)
-	{
-		ereport(ERROR,
-				(errcode(ERRCODE_STATEMENT_TOO_COMPLEX),
-				 (errmsg("Query plan size limit exceeded, current size: "
-						 UINT64_FORMAT "KB, max allowed size: %dKB",
-						 plan_size_in_kb, gp_max_plan_size),
-				  errhint("Size controlled by gp_max_plan_size"))));
-	}
+		if (0 < gp_max_plan_size && plan_size_in_kb > gp_max_plan_size)
+		{
+			ereport(ERROR,
+					(errcode(ERRCODE_STATEMENT_TOO_COMPLEX),
+					 (errmsg("Query plan size limit exceeded, current size: "
+							 UINT64_FORMAT "KB, max allowed size: %dKB",
+							 plan_size_in_kb, gp_max_plan_size),
+					  errhint("Size controlled by gp_max_plan_size"))));
+		}
+
+		Assert(splan != NULL && splan_len > 0 && splan_len_uncompressed > 0);
 
-	Assert(splan != NULL && splan_len > 0 && splan_len_uncompressed > 0);
+		queryDesc->dispatchedStmt = queryDesc->plannedstmt;
+		queryDesc->serializedPlan = splan;
+		queryDesc->serializedPlanLen = splan_len;
+	}
 
 	if (queryDesc->params != NULL && queryDesc->params->numParams > 0)
 	{
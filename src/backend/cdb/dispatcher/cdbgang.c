@@ -102,6 +102,8 @@ AllocateGang(CdbDispatcherState *ds, GangType type, List *segments)
 	MemoryContext	oldContext;
 	SegmentType 	segmentType;
 	Gang			*newGang = NULL;
+	int64			hitsBefore;
+	int64			missesBefore;
 	int				i;
 
 	ELOG_DISPATCHER_DEBUG("AllocateGang begin.");
@@ -125,10 +127,25 @@ AllocateGang(CdbDispatcherState *ds, GangType type, List *segments)
 	else
 		segmentType = SEGMENTTYPE_ANY;
 
+	cdbcomponent_getIdleQEStats(&hitsBefore, &missesBefore);
+
 	newGang = cdbgang_createGang(segments, segmentType);
 	newGang->allocated = true;
 	newGang->type = type;
 
+	if (log_dispatch_stats)
+	{
+		int64		hits;
+		int64		misses;
+
+		cdbcomponent_getIdleQEStats(&hits, &misses);
+		elog(LOG, "allocated %s gang of %d QEs: " INT64_FORMAT " reused from idle QE pool, "
+			 INT64_FORMAT " newly connected (session total: " INT64_FORMAT " reused, "
+			 INT64_FORMAT " newly connected)",
+			 gangTypeToString(type), newGang->size,
+			 hits - hitsBefore, misses - missesBefore, hits, misses);
+	}
+
 	/*
 	 * Push to the head of the allocated list, later in
 	 * cdbdisp_destroyDispatcherState() we should recycle them from the head to
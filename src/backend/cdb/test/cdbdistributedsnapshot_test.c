@@ -164,6 +164,60 @@ test__DistributedSnapshotWithLocalMapping_CommittedTest(void **state)
 	free(dslm.inProgressMappedLocalXids);
 }
 
+static void
+test__DistributedSnapshot_Serialize_Deserialize(void **state)
+{
+	DistributedSnapshot ds;
+	DistributedSnapshot copy;
+	DistributedTransactionId xids[] = {1000, 1001, 1127, 1128, 1300, 50000, 4000000};
+	int			nxids = lengthof(xids);
+	char	   *buf;
+	int			size;
+	int			i;
+
+	ds.distribTransactionTimeStamp = time(NULL);
+	ds.xminAllDistributedSnapshots = 900;
+	ds.distribSnapshotId = 12345;
+	ds.xmin = 1000;
+	ds.xmax = 4000001;
+	ds.count = nxids;
+	ds.inProgressXidArray = xids;
+
+	/* deltas of 0, 1, 126 and 1 take one byte each, the rest more */
+	size = DistributedSnapshot_SerializeSize(&ds);
+	assert_true(size < sizeof(DistributedTransactionTimeStamp) +
+				sizeof(DistributedSnapshotId) +
+				4 * sizeof(DistributedTransactionId) +
+				nxids * sizeof(DistributedTransactionId));
+
+	buf = malloc(size);
+	assert_int_equal(DistributedSnapshot_Serialize(&ds, buf), size);
+
+	copy.inProgressXidArray =
+		(DistributedTransactionId *) malloc(SIZE_OF_IN_PROGRESS_ARRAY);
+	assert_int_equal(DistributedSnapshot_Deserialize(buf, &copy), size);
+
+	assert_int_equal(copy.distribTransactionTimeStamp, ds.distribTransactionTimeStamp);
+	assert_int_equal(copy.xminAllDistributedSnapshots, ds.xminAllDistributedSnapshots);
+	assert_int_equal(copy.distribSnapshotId, ds.distribSnapshotId);
+	assert_int_equal(copy.xmin, ds.xmin);
+	assert_int_equal(copy.xmax, ds.xmax);
+	assert_int_equal(copy.count, ds.count);
+	for (i = 0; i < nxids; i++)
+		assert_int_equal(copy.inProgressXidArray[i], xids[i]);
+
+	/* every xid in the array is found, and nothing else */
+	for (i = 0; i < nxids; i++)
+	{
+		assert_true(DistributedSnapshot_XidInProgress(&copy, xids[i]));
+		assert_false(DistributedSnapshot_XidInProgress(&copy, xids[i] + 2));
+	}
+	assert_false(DistributedSnapshot_XidInProgress(&copy, 999));
+
+	free(copy.inProgressXidArray);
+	free(buf);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -171,7 +225,8 @@ main(int argc, char* argv[])
 
 	const UnitTest tests[] =
 	{
-		unit_test(test__DistributedSnapshotWithLocalMapping_CommittedTest)
+		unit_test(test__DistributedSnapshotWithLocalMapping_CommittedTest),
+		unit_test(test__DistributedSnapshot_Serialize_Deserialize)
 	};
 
 	MemoryContextInit();
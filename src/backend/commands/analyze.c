@@ -107,6 +107,7 @@
 #include "utils/acl.h"
 #include "utils/attoptcache.h"
 #include "utils/datum.h"
+#include "utils/faultinjector.h"
 #include "utils/guc.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
@@ -119,6 +120,7 @@
 #include "utils/typcache.h"
 
 #include "catalog/heap.h"
+#include "catalog/gp_fastsequence.h"
 #include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbaocsam.h"
 #include "cdb/cdbdisp_query.h"
@@ -1572,13 +1574,291 @@ acquire_sample_rows_heap(Relation onerel, int elevel,
 	return numrows;
 }
 
+/*
+ * Sampling an AO table through its block directory only pays off if we
+ * probe a small fraction of the table. If the number of row numbers we'd
+ * have to probe is more than 1/AO_BLKDIR_SAMPLE_MIN_RATIO of the live rows,
+ * most varblocks would get decompressed anyway, and a sequential scan is
+ * cheaper.
+ */
+#define AO_BLKDIR_SAMPLE_MIN_RATIO		10
+
+/*
+ * Probe this many more row numbers than the expected minimum, so that the
+ * sample comes out at, or slightly above, targrows in most cases.
+ */
+#define AO_BLKDIR_SAMPLE_OVERSHOOT		1.1
+
+/*
+ * qsort comparator for sorting the row numbers to probe
+ */
+static int
+compare_rownums(const void *a, const void *b)
+{
+	int64		ra = *(const int64 *) a;
+	int64		rb = *(const int64 *) b;
+
+	if (ra < rb)
+		return -1;
+	if (ra > rb)
+		return 1;
+	return 0;
+}
+
+/*
+ * Collect a sample of rows from an AO or AOCS table that has a block
+ * directory, without scanning the whole table.
+ *
+ * Every row in an AO segment file has a row number between 1 and the
+ * segment's last gp_fastsequence value. We lay the row number ranges of all
+ * segment files end to end, pick random positions in that space, and fetch
+ * them in sorted order through the block directory, the same way an index
+ * scan would. Row numbers that fall into a gap, or that belong to an
+ * aborted or deleted row, are simply not found, so every live row has the
+ * same chance of being picked. If we happen to find more than targrows
+ * rows, the surplus is thinned out with a reservoir.
+ *
+ * Returns -1, without collecting anything, if the table is too small or has
+ * too sparse row numbers for this to beat a full scan.
+ */
+static int
+acquire_sample_rows_ao_blkdir(Relation onerel, int elevel,
+							  HeapTuple *rows, int targrows,
+							  double *totalrows, double *totaldeadrows)
+{
+	AppendOnlyFetchDesc aoFetchDesc = NULL;
+	AOCSFetchDesc aocsFetchDesc = NULL;
+	bool	   *proj = NULL;
+	AppendOnlyVisimap *visiMap;
+	Snapshot	appendOnlyMetaDataSnapshot;
+	FileSegTotals *fstotal;
+	int64		hidden_tupcount;
+	double		liverows;
+	int			totalsegs;
+	int			nsegs;
+	int32	   *segnos;
+	int64	   *segends;
+	int64		rownumspace;
+	double		nprobes_est;
+	int64		nprobes;
+	int64	   *probes;
+	int64		nprobed;
+	int64		i;
+	int			seg;
+	TupleTableSlot *slot;
+	int			numrows = 0;	/* # rows now in reservoir */
+	double		samplerows = 0; /* total # rows found */
+
+	fstotal = RelationIsAoRows(onerel) ?
+		GetSegFilesTotals(onerel, SnapshotSelf) :
+		GetAOCSSSegFilesTotals(onerel, SnapshotSelf);
+
+	/* Quick exit for small tables, before opening the block directory. */
+	if ((double) fstotal->totaltuples <
+		(double) targrows * AO_BLKDIR_SAMPLE_OVERSHOOT * AO_BLKDIR_SAMPLE_MIN_RATIO)
+		return -1;
+
+	appendOnlyMetaDataSnapshot = GetTransactionSnapshot();
+
+	if (RelationIsAoRows(onerel))
+	{
+		aoFetchDesc = appendonly_fetch_init(onerel,
+											SnapshotSelf,
+											appendOnlyMetaDataSnapshot);
+		visiMap = &aoFetchDesc->visibilityMap;
+		totalsegs = aoFetchDesc->totalSegfiles;
+	}
+	else
+	{
+		int			natts = RelationGetNumberOfAttributes(onerel);
+
+		/* The block directory keeps a pointer to this until the finish */
+		proj = (bool *) palloc(natts * sizeof(bool));
+		for (i = 0; i < natts; i++)
+			proj[i] = true;
+
+		Assert(RelationIsAoCols(onerel));
+		aocsFetchDesc = aocs_fetch_init(onerel,
+										SnapshotSelf,
+										appendOnlyMetaDataSnapshot,
+										proj);
+		visiMap = &aocsFetchDesc->visibilityMap;
+		totalsegs = aocsFetchDesc->totalSegfiles;
+	}
+
+	hidden_tupcount = AppendOnlyVisimap_GetRelationHiddenTupleCount(visiMap);
+	liverows = (double) fstotal->totaltuples - hidden_tupcount;
+
+	/*
+	 * Lay out the row number range of each segment file. segends[n] is the
+	 * end (exclusive) of segment n's range in the combined space.
+	 */
+	segnos = (int32 *) palloc(Max(totalsegs, 1) * sizeof(int32));
+	segends = (int64 *) palloc(Max(totalsegs, 1) * sizeof(int64));
+	rownumspace = 0;
+	nsegs = 0;
+	for (seg = 0; seg < totalsegs; seg++)
+	{
+		int32		segno;
+		int64		tupcount;
+		FileSegInfoState state;
+		int64		lastrownum;
+
+		if (aoFetchDesc)
+		{
+			segno = aoFetchDesc->segmentFileInfo[seg]->segno;
+			tupcount = aoFetchDesc->segmentFileInfo[seg]->total_tupcount;
+			state = aoFetchDesc->segmentFileInfo[seg]->state;
+		}
+		else
+		{
+			segno = aocsFetchDesc->segmentFileInfo[seg]->segno;
+			tupcount = aocsFetchDesc->segmentFileInfo[seg]->total_tupcount;
+			state = aocsFetchDesc->segmentFileInfo[seg]->state;
+		}
+
+		/*
+		 * Segment files awaiting drop have been compacted away, and don't
+		 * count towards the live rows either.
+		 */
+		if (tupcount <= 0 || state == AOSEG_STATE_AWAITING_DROP)
+			continue;
+
+		lastrownum = ReadLastSequence(onerel->rd_appendonly->segrelid, segno);
+		if (lastrownum <= 0)
+			continue;
+
+		rownumspace += lastrownum;
+		segnos[nsegs] = segno;
+		segends[nsegs] = rownumspace;
+		nsegs++;
+	}
+
+	nprobes_est = 0;
+	if (liverows > 0)
+		nprobes_est = ceil((double) targrows * AO_BLKDIR_SAMPLE_OVERSHOOT *
+						   ((double) rownumspace / liverows));
+	if (liverows <= 0 || rownumspace <= 0 ||
+		nprobes_est * AO_BLKDIR_SAMPLE_MIN_RATIO > liverows ||
+		nprobes_est > (double) (MaxAllocSize / sizeof(int64)))
+	{
+		pfree(segnos);
+		pfree(segends);
+		if (aoFetchDesc)
+		{
+			appendonly_fetch_finish(aoFetchDesc);
+			pfree(aoFetchDesc);
+		}
+		else
+		{
+			aocs_fetch_finish(aocsFetchDesc);
+			pfree(aocsFetchDesc);
+			pfree(proj);
+		}
+		return -1;
+	}
+	nprobes = (int64) nprobes_est;
+
+	SIMPLE_FAULT_INJECTOR("analyze_ao_blkdir_sample");
+
+	/* Pick the positions to probe, and sort them into physical order. */
+	probes = (int64 *) palloc(nprobes * sizeof(int64));
+	for (i = 0; i < nprobes; i++)
+	{
+		int64		pos = (int64) (anl_random_fract() * (double) rownumspace);
+
+		probes[i] = Min(pos, rownumspace - 1);
+	}
+	qsort(probes, nprobes, sizeof(int64), compare_rownums);
+
+	slot = MakeSingleTupleTableSlot(RelationGetDescr(onerel));
+
+	seg = 0;
+	nprobed = 0;
+	for (i = 0; i < nprobes; i++)
+	{
+		AOTupleId	aoTupleId;
+		int64		segstart;
+		bool		found;
+
+		/* Each position is probed only once. */
+		if (i > 0 && probes[i] == probes[i - 1])
+			continue;
+
+		vacuum_delay_point();
+
+		while (probes[i] >= segends[seg])
+			seg++;
+		segstart = (seg == 0) ? 0 : segends[seg - 1];
+
+		AOTupleIdInit(&aoTupleId, segnos[seg], probes[i] - segstart + 1);
+		nprobed++;
+
+		if (aoFetchDesc)
+			found = appendonly_fetch(aoFetchDesc, &aoTupleId, slot);
+		else
+			found = aocs_fetch(aocsFetchDesc, &aoTupleId, slot);
+		if (!found)
+			continue;
+
+		if (numrows < targrows)
+			rows[numrows++] = ExecCopySlotHeapTuple(slot);
+		else
+		{
+			/*
+			 * Found more rows than we need. Keep each of the rows found so
+			 * far with equal probability.
+			 */
+			int			k = (int) ((samplerows + 1) * anl_random_fract());
+
+			if (k < targrows)
+			{
+				heap_freetuple(rows[k]);
+				rows[k] = ExecCopySlotHeapTuple(slot);
+			}
+		}
+		samplerows += 1;
+	}
+
+	*totalrows = liverows;
+	/* We always report 0 dead rows on an AO table, like the full scan does. */
+	*totaldeadrows = 0;
+
+	ereport(elevel,
+			(errmsg("\"%s\": probed " INT64_FORMAT " of " INT64_FORMAT " row numbers "
+					"through the block directory, "
+					"%d rows in sample, %.0f estimated total rows",
+					RelationGetRelationName(onerel),
+					nprobed, rownumspace,
+					numrows, *totalrows)));
+
+	ExecDropSingleTupleTableSlot(slot);
+	pfree(probes);
+	pfree(segnos);
+	pfree(segends);
+	if (aoFetchDesc)
+	{
+		appendonly_fetch_finish(aoFetchDesc);
+		pfree(aoFetchDesc);
+	}
+	else
+	{
+		aocs_fetch_finish(aocsFetchDesc);
+		pfree(aocsFetchDesc);
+		pfree(proj);
+	}
+
+	return numrows;
+}
+
 /*
  * Collect a sample of rows from an AO or AOCS table.
  *
  * The block-sampling method used for heap tables doesn't work with
- * append-only tables. We could build a reasonably efficient block-sampling
- * method for AO tables, too, using the block directory, if it's available.
- * But for now, this scans the whole table.
+ * append-only tables. If the table has a block directory, and is large
+ * enough compared to the sample size, we sample it by fetching random row
+ * numbers through the block directory (see acquire_sample_rows_ao_blkdir).
+ * Otherwise, this scans the whole table.
  */
 static int
 acquire_sample_rows_ao(Relation onerel, int elevel,
@@ -1594,6 +1874,16 @@ acquire_sample_rows_ao(Relation onerel, int elevel,
 	double		samplerows = 0; /* total # rows collected */
 	double		rowstoskip = -1;	/* -1 means not set yet */
 
+	if (OidIsValid(onerel->rd_appendonly->blkdirrelid))
+	{
+		numrows = acquire_sample_rows_ao_blkdir(onerel, elevel,
+												rows, targrows,
+												totalrows, totaldeadrows);
+		if (numrows >= 0)
+			return numrows;
+		numrows = 0;
+	}
+
 	/*
 	 * the append-only meta data should never be fetched with
 	 * SnapshotAny as bogus results are returned.
@@ -4008,6 +4298,30 @@ compute_scalar_stats(VacAttrStatsP stats,
 	/* We don't need to bother cleaning up any of our temporary palloc's */
 }
 
+/*
+ * Return a private, unpacked copy of an HLL counter, which can be used as
+ * either argument of gp_hll_merge().
+ *
+ * gp_hll_unpack() scribbles on the header of a packed or compressed input,
+ * so it must not be applied to a counter that's still in use elsewhere,
+ * like one that points into a pg_statistic tuple.
+ */
+static GpHLLCounter
+hll_unpacked_copy(GpHLLCounter counter)
+{
+	GpHLLCounter copy;
+	GpHLLCounter unpacked;
+
+	if (counter->format == UNPACKED || counter->format == UNPACKED_UNPACKED)
+		return gp_hll_copy(counter);
+
+	copy = gp_hll_copy(counter);
+	unpacked = gp_hll_unpack(copy);
+	pfree(copy);
+
+	return unpacked;
+}
+
 /*
  *	merge_leaf_stats() -- merge leaf stats for the root
  *
@@ -4082,6 +4396,8 @@ merge_leaf_stats(VacAttrStatsP stats,
 	int fullhll_count = 0;
 	int samplehll_count = 0;
 	int totalhll_count = 0;
+	const char *attname = get_relid_attribute_name(stats->attr->attrelid, stats->attr->attnum);
+
 	foreach (lc, oid_list)
 	{
 		Oid relid = lfirst_oid(lc);
@@ -4091,7 +4407,6 @@ merge_leaf_stats(VacAttrStatsP stats,
 		nullCount = nullCount +
 					get_attnullfrac(relid, stats->attr->attnum) * relTuples[i];
 
-		const char *attname = get_relid_attribute_name(stats->attr->attrelid, stats->attr->attnum);
 		AttrNumber child_attno = get_attnum(relid, attname);
 
 		heaptupleStats[i] = get_att_stats(relid, child_attno);
@@ -4131,13 +4446,11 @@ merge_leaf_stats(VacAttrStatsP stats,
 			nDistincts[i] = (float) hllcounters[i]->ndistinct;
 			nMultiples[i] = (float) hllcounters[i]->nmultiples;
 			sampleCount += hllcounters[i]->samplerows;
-			hllcounters_copy[i] = gp_hll_copy(hllcounters[i]);
-			GpHLLCounter finalHLL_intermediate = finalHLL;
-			finalHLL = gp_hyperloglog_merge_counters(finalHLL_intermediate, hllcounters[i]);
-			if (NULL != finalHLL_intermediate)
-			{
-				pfree(finalHLL_intermediate);
-			}
+			hllcounters_copy[i] = hll_unpacked_copy(hllcounters[i]);
+			if (finalHLL == NULL)
+				finalHLL = gp_hll_copy(hllcounters_copy[i]);
+			else
+				gp_hll_merge(finalHLL, hllcounters_copy[i]);
 			free_attstatsslot(&hllSlot);
 			samplehll_count++;
 			totalhll_count++;
@@ -4233,8 +4546,11 @@ merge_leaf_stats(VacAttrStatsP stats,
 				 */
 				GpHLLCounter *hllcounters_right = (GpHLLCounter *) palloc0(numPartitions * sizeof(GpHLLCounter));
 
-				hllcounters_left[0] = gp_hyperloglog_init_def();
-				hllcounters_right[numPartitions - 1] = gp_hyperloglog_init_def();
+				GpHLLCounter hllcounter_default = gp_hyperloglog_init_def();
+
+				hllcounters_left[0] = hll_unpacked_copy(hllcounter_default);
+				hllcounters_right[numPartitions - 1] = gp_hll_copy(hllcounters_left[0]);
+				pfree(hllcounter_default);
 
 				/*
 				 * The following loop populates the left and right array by accumulating the merged
@@ -4253,64 +4569,50 @@ merge_leaf_stats(VacAttrStatsP stats,
 				 * are default values since there is no element towards
 				 * the left or right of them
 				 */
+				/*
+				 * All the counters involved are unpacked private copies, so
+				 * each step is just a copy of the neighbor plus an in-place
+				 * merge of one leaf counter.
+				 */
 				for (i = 1; i < numPartitions; i++)
 				{
 					/* populate left array */
-					if (nDistincts[i - 1] == 0)
-					{
-						hllcounters_left[i] = gp_hll_copy(hllcounters_left[i - 1]);
-					}
-					else
-					{
-						GpHLLCounter hllcounter_temp1 = gp_hll_copy(hllcounters_copy[i - 1]);
-						GpHLLCounter hllcounter_temp2 = gp_hll_copy(hllcounters_left[i - 1]);
-						hllcounters_left[i] = gp_hyperloglog_merge_counters(hllcounter_temp1, hllcounter_temp2);
-						pfree(hllcounter_temp1);
-						pfree(hllcounter_temp2);
-					}
+					hllcounters_left[i] = gp_hll_copy(hllcounters_left[i - 1]);
+					if (nDistincts[i - 1] != 0)
+						gp_hll_merge(hllcounters_left[i], hllcounters_copy[i - 1]);
 
 					/* populate right array */
-					if (nDistincts[numPartitions - i] == 0)
-					{
-						hllcounters_right[numPartitions - i - 1] = gp_hll_copy(hllcounters_right[numPartitions - i]);
-					}
-					else
-					{
-						GpHLLCounter hllcounter_temp1 = gp_hll_copy(hllcounters_copy[numPartitions - i]);
-						GpHLLCounter hllcounter_temp2 = gp_hll_copy(hllcounters_right[numPartitions - i]);
-						hllcounters_right[numPartitions - i - 1] = gp_hyperloglog_merge_counters(hllcounter_temp1, hllcounter_temp2);
-						pfree(hllcounter_temp1);
-						pfree(hllcounter_temp2);
-					}
+					hllcounters_right[numPartitions - i - 1] = gp_hll_copy(hllcounters_right[numPartitions - i]);
+					if (nDistincts[numPartitions - i] != 0)
+						gp_hll_merge(hllcounters_right[numPartitions - i - 1],
+									 hllcounters_copy[numPartitions - i]);
 				}
 
 				int nUnique = 0;
 				for (i = 0; i < numPartitions; i++)
 				{
+					float		nUniques;
+
 					/* Skip if statistics are missing for the partition */
 					if (nDistincts[i] == 0)
 						continue;
 
-					GpHLLCounter hllcounter_temp1 = gp_hll_copy(hllcounters_left[i]);
-					GpHLLCounter hllcounter_temp2 = gp_hll_copy(hllcounters_right[i]);
-					GpHLLCounter final = NULL;
-					final = gp_hyperloglog_merge_counters(hllcounter_temp1, hllcounter_temp2);
+					/*
+					 * hllcounters_left[i] is not needed after this, so merge
+					 * the right side into it in place, to get the counter for
+					 * all partitions except this one.
+					 */
+					gp_hll_merge(hllcounters_left[i], hllcounters_right[i]);
 
-					pfree(hllcounter_temp1);
-					pfree(hllcounter_temp2);
+					nUniques = ndistinct - gp_hyperloglog_estimate(hllcounters_left[i]);
+					nUnique += nUniques;
+					nmultiple += nMultiples[i] * (nUniques / nDistincts[i]);
+				}
 
-					if (final != NULL)
-					{
-						float nUniques = ndistinct - gp_hyperloglog_estimate(final);
-						nUnique += nUniques;
-						nmultiple += nMultiples[i] * (nUniques / nDistincts[i]);
-						pfree(final);
-					}
-					else
-					{
-						nUnique = ndistinct;
-						break;
-					}
+				for (i = 0; i < numPartitions; i++)
+				{
+					pfree(hllcounters_left[i]);
+					pfree(hllcounters_right[i]);
 				}
 
 				// nmultiples for the ROOT
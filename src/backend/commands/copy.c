@@ -163,6 +163,8 @@ static void CopyFromInsertBatch(CopyState cstate, EState *estate,
 					BulkInsertState bistate,
 					int nBufferedTuples, HeapTuple *bufferedTuples,
 					uint64 firstBufferedLineNo);
+static void CopyFromInsertBatchAOCS(ResultRelInfo *resultRelInfo,
+						int nBufferedTuples, HeapTuple *bufferedTuples);
 static bool CopyReadLine(CopyState cstate);
 static bool CopyReadLineText(CopyState cstate);
 static int	CopyReadAttributesText(CopyState cstate, int stop_processing_at_field);
@@ -3784,6 +3786,9 @@ CopyFrom(CopyState cstate)
 	 * expressions. Such triggers or expressions might query the table we're
 	 * inserting to, and act differently if the tuples that have already been
 	 * processed and prepared for insertion are not there.
+	 *
+	 * In GPDB, the same batching is used for append-only column-oriented
+	 * tables, so that each batch can be written one column at a time.
 	 */
 	if ((resultRelInfo->ri_TrigDesc != NULL &&
 		 (resultRelInfo->ri_TrigDesc->trig_insert_before_row ||
@@ -4176,7 +4181,8 @@ CopyFrom(CopyState cstate)
 				ExecConstraints(resultRelInfo, slot, estate);
 
 			/* OK, store the tuple and create index entries for it */
-			if (useHeapMultiInsert && relstorage == RELSTORAGE_HEAP)
+			if (useHeapMultiInsert &&
+				(relstorage == RELSTORAGE_HEAP || relstorage == RELSTORAGE_AOCOLS))
 			{
 				HeapTuple	tuple;
 				if (resultRelInfo->nBufferedTuples == 0)
@@ -4467,6 +4473,44 @@ CopyFrom(CopyState cstate)
 	return processed;
 }
 
+/*
+ * A subroutine of CopyFromInsertBatch, to write a batch of buffered tuples
+ * to an append-only, column-oriented table. The tuples are handed to
+ * aocs_insert_values_multi(), which writes them one column at a time. The
+ * TIDs assigned to the rows are stored back in the tuples' t_self, for the
+ * index and trigger processing that follows.
+ *
+ * Called in the per-tuple memory context.
+ */
+static void
+CopyFromInsertBatchAOCS(ResultRelInfo *resultRelInfo,
+						int nBufferedTuples, HeapTuple *bufferedTuples)
+{
+	TupleDesc	tupDesc = RelationGetDescr(resultRelInfo->ri_RelationDesc);
+	int			natts = tupDesc->natts;
+	Datum	  **values;
+	bool	  **nulls;
+	AOTupleId  *aoTupleIds;
+	int			i;
+
+	values = palloc(nBufferedTuples * sizeof(Datum *));
+	nulls = palloc(nBufferedTuples * sizeof(bool *));
+	aoTupleIds = palloc(nBufferedTuples * sizeof(AOTupleId));
+
+	for (i = 0; i < nBufferedTuples; i++)
+	{
+		values[i] = palloc(natts * sizeof(Datum));
+		nulls[i] = palloc(natts * sizeof(bool));
+		heap_deform_tuple(bufferedTuples[i], tupDesc, values[i], nulls[i]);
+	}
+
+	aocs_insert_values_multi(resultRelInfo->ri_aocsInsertDesc,
+							 values, nulls, nBufferedTuples, aoTupleIds);
+
+	for (i = 0; i < nBufferedTuples; i++)
+		bufferedTuples[i]->t_self = *((ItemPointer) &aoTupleIds[i]);
+}
+
 /*
  * A subroutine of CopyFrom, to write the current batch of buffered heap
  * tuples to the heap. Also updates indexes and runs AFTER ROW INSERT
@@ -4495,13 +4539,16 @@ CopyFromInsertBatch(CopyState cstate, EState *estate, CommandId mycid,
 	 * before calling it.
 	 */
 	oldcontext = MemoryContextSwitchTo(GetPerTupleMemoryContext(estate));
-	heap_multi_insert(resultRelInfo->ri_RelationDesc,
-					  bufferedTuples,
-					  nBufferedTuples,
-					  mycid,
-					  hi_options,
-					  bistate,
-					  GetCurrentTransactionId());
+	if (RelinfoGetStorage(resultRelInfo) == RELSTORAGE_AOCOLS)
+		CopyFromInsertBatchAOCS(resultRelInfo, nBufferedTuples, bufferedTuples);
+	else
+		heap_multi_insert(resultRelInfo->ri_RelationDesc,
+						  bufferedTuples,
+						  nBufferedTuples,
+						  mycid,
+						  hi_options,
+						  bistate,
+						  GetCurrentTransactionId());
 	MemoryContextSwitchTo(oldcontext);
 
 	/*
@@ -6130,6 +6177,58 @@ CopyReadLine(CopyState cstate)
 	return result;
 }
 
+/*
+ * Helper for CopyReadLineText: return the position of the first byte in
+ * buf[ptr .. len - 1] that is one of the 'nchars' characters in 'chars', or
+ * has its high bit set if 'stop_at_highbit'.  Returns 'len' if there is no
+ * such byte.
+ *
+ * Most of the input is ordinary data bytes, so check eight of them at a
+ * time first, with the usual trick for finding a zero byte in a word.  That
+ * test can have false positives, but not false negatives, so the exact
+ * position is found by the byte-at-a-time loop after it.
+ */
+#define COPY_SCAN_ONES			UINT64CONST(0x0101010101010101)
+#define COPY_SCAN_HIGHBITS		UINT64CONST(0x8080808080808080)
+#define COPY_SCAN_HAS_ZERO(v)	(((v) - COPY_SCAN_ONES) & ~(v) & COPY_SCAN_HIGHBITS)
+
+static inline int
+CopyScanToSpecialChar(const char *buf, int ptr, int len,
+					  const char *chars, int nchars, bool stop_at_highbit)
+{
+	while (ptr + (int) sizeof(uint64) <= len)
+	{
+		uint64		word;
+		uint64		hit;
+		int			i;
+
+		memcpy(&word, buf + ptr, sizeof(uint64));
+
+		hit = stop_at_highbit ? (word & COPY_SCAN_HIGHBITS) : 0;
+		for (i = 0; i < nchars; i++)
+		{
+			uint64		x = word ^ (COPY_SCAN_ONES * (unsigned char) chars[i]);
+
+			hit |= COPY_SCAN_HAS_ZERO(x);
+		}
+		if (hit != 0)
+			break;
+		ptr += sizeof(uint64);
+	}
+
+	for (; ptr < len; ptr++)
+	{
+		char		c = buf[ptr];
+
+		if (stop_at_highbit && IS_HIGHBIT_SET(c))
+			break;
+		if (memchr(chars, c, nchars) != NULL)
+			break;
+	}
+
+	return ptr;
+}
+
 /*
  * CopyReadLineText - inner loop of CopyReadLine for text mode
  */
@@ -6151,6 +6250,10 @@ CopyReadLineText(CopyState cstate)
 	char		quotec = '\0';
 	char		escapec = '\0';
 
+	/* characters that the loop below must look at one by one */
+	char		special_chars[5];
+	int			nspecial_chars = 0;
+
 	if (cstate->csv_mode)
 	{
 		quotec = cstate->quote[0];
@@ -6160,6 +6263,16 @@ CopyReadLineText(CopyState cstate)
 			escapec = '\0';
 	}
 
+	special_chars[nspecial_chars++] = '\n';
+	special_chars[nspecial_chars++] = '\r';
+	special_chars[nspecial_chars++] = '\\';
+	if (cstate->csv_mode)
+	{
+		special_chars[nspecial_chars++] = quotec;
+		if (escapec != '\0')
+			special_chars[nspecial_chars++] = escapec;
+	}
+
 	mblen_str[1] = '\0';
 
 	/*
@@ -6190,6 +6303,7 @@ CopyReadLineText(CopyState cstate)
 	for (;;)
 	{
 		int			prev_raw_ptr;
+		int			special_ptr;
 		char		c;
 
 		/*
@@ -6227,6 +6341,25 @@ CopyReadLineText(CopyState cstate)
 			need_data = false;
 		}
 
+		/*
+		 * Skip over any run of bytes that need no processing here, that is,
+		 * anything but newlines, backslashes, the CSV quote and escape
+		 * characters, and the lead bytes of multi-byte characters in
+		 * encodings that can embed ASCII.  They are simply transferred to
+		 * line_buf along with the rest of the line.
+		 */
+		special_ptr = CopyScanToSpecialChar(copy_raw_buf, raw_buf_ptr,
+											copy_buf_len,
+											special_chars, nspecial_chars,
+											cstate->encoding_embeds_ascii);
+		if (special_ptr > raw_buf_ptr)
+		{
+			raw_buf_ptr = special_ptr;
+			first_char_in_line = false;
+			last_was_esc = false;
+			continue;
+		}
+
 		/* OK to fetch a character */
 		prev_raw_ptr = raw_buf_ptr;
 		c = copy_raw_buf[raw_buf_ptr++];
@@ -21,6 +21,7 @@
 #include "executor/nodeSort.h"
 #include "lib/stringinfo.h"             /* StringInfo */
 #include "miscadmin.h"
+#include "utils/lsyscache.h"
 #include "utils/tuplesort.h"
 #include "cdb/cdbvars.h" /* CDB *//* gp_sort_flags */
 #include "utils/workfile_mgr.h"
@@ -170,9 +171,25 @@ ExecSort(SortState *node)
 	 */
 	if (!node->sort_Done)
 	{
+		bool		stopAtPresortedBound;
+		int64		ntuples = 0;
 
 		Assert(outerNode != NULL);
 
+		/*
+		 * If only the first 'bound' tuples are needed, and the input is
+		 * already sorted on a prefix of the sort keys, we don't need to read
+		 * all of the input. Once we have seen 'bound' tuples, any later
+		 * tuple whose prefix differs from the bound'th tuple's sorts after
+		 * all of them, and so do all tuples following it.
+		 *
+		 * That doesn't hold if duplicates are discarded, as the first
+		 * 'bound' tuples might not all survive.
+		 */
+		stopAtPresortedBound = (node->presortedEqfunctions != NULL &&
+								node->bounded && node->bound > 0 &&
+								!node->noduplicates);
+
 		/*
 		 * Scan the subplan and feed all the tuples to tuplesort.
 		 */
@@ -184,6 +201,25 @@ ExecSort(SortState *node)
 			if (TupIsNull(slot))
 				break;
 
+			if (stopAtPresortedBound)
+			{
+				ntuples++;
+				if (ntuples == node->bound)
+					ExecCopySlot(node->presortedBoundSlot, slot);
+				else if (ntuples > node->bound)
+				{
+					ExprContext *econtext = node->ss.ps.ps_ExprContext;
+
+					ResetExprContext(econtext);
+					if (!execTuplesMatch(slot, node->presortedBoundSlot,
+										 plannode->numPresortedCols,
+										 plannode->sortColIdx,
+										 node->presortedEqfunctions,
+										 econtext->ecxt_per_tuple_memory))
+						break;
+				}
+			}
+
 			tuplesort_puttupleslot(tuplesortstate, slot);
 		}
 
@@ -304,6 +340,31 @@ ExecInitSort(Sort *node, EState *estate, int eflags)
 		sortstate->noduplicates = node->noduplicates;
 	}
 
+	/*
+	 * If the input is presorted on some leading sort columns, prepare to
+	 * compare those, in case we get a bound (see ExecSort).
+	 */
+	sortstate->presortedEqfunctions = NULL;
+	sortstate->presortedBoundSlot = NULL;
+	if (node->numPresortedCols > 0)
+	{
+		Oid		   *eqOperators;
+		int			i;
+
+		eqOperators = (Oid *) palloc(node->numPresortedCols * sizeof(Oid));
+		for (i = 0; i < node->numPresortedCols; i++)
+		{
+			eqOperators[i] = get_equality_op_for_ordering_op(node->sortOperators[i],
+															 NULL);
+			if (!OidIsValid(eqOperators[i]))
+				elog(ERROR, "could not find equality operator for ordering operator %u",
+					 node->sortOperators[i]);
+		}
+		sortstate->presortedEqfunctions =
+			execTuplesMatchPrepare(node->numPresortedCols, eqOperators);
+		pfree(eqOperators);
+	}
+
 	/*
 	 * Miscellaneous initialization
 	 *
@@ -318,6 +379,8 @@ ExecInitSort(Sort *node, EState *estate, int eflags)
 	 */
 	ExecInitResultTupleSlot(estate, &sortstate->ss.ps);
 	sortstate->ss.ss_ScanTupleSlot = ExecInitExtraTupleSlot(estate);
+	if (sortstate->presortedEqfunctions != NULL)
+		sortstate->presortedBoundSlot = ExecInitExtraTupleSlot(estate);
 
 	/* 
 	 * CDB: Offer extra info for EXPLAIN ANALYZE.
@@ -377,6 +440,9 @@ ExecInitSort(Sort *node, EState *estate, int eflags)
 	ExecAssignResultTypeFromTL(&sortstate->ss.ps);
 	ExecAssignScanTypeFromOuterPlan(&sortstate->ss);
 	sortstate->ss.ps.ps_ProjInfo = NULL;
+	if (sortstate->presortedBoundSlot != NULL)
+		ExecSetSlotDescriptor(sortstate->presortedBoundSlot,
+							  ExecGetResultType(outerPlanState(sortstate)));
 
 	if(node->share_type != SHARE_NOTSHARED)
 	{
@@ -543,6 +609,8 @@ ExecEagerFreeSort(SortState *node)
 
 	/* clean out the tuple table */
 	ExecClearTuple(node->ss.ss_ScanTupleSlot);
+	if (node->presortedBoundSlot != NULL)
+		ExecClearTuple(node->presortedBoundSlot);
 
 	/* must drop pointer to sort result tuple */
 	ExecClearTuple(node->ss.ps.ps_ResultTupleSlot);
@@ -112,6 +112,7 @@ typedef struct WindowStatePerAggData
 	Oid			transfn_oid;
 	Oid			invtransfn_oid; /* may be InvalidOid */
 	Oid			finalfn_oid;	/* may be InvalidOid */
+	Oid			combinefn_oid;	/* may be InvalidOid */
 
 	/*
 	 * fmgr lookup data for transition functions --- only valid when
@@ -121,6 +122,7 @@ typedef struct WindowStatePerAggData
 	FmgrInfo	transfn;
 	FmgrInfo	invtransfn;
 	FmgrInfo	finalfn;
+	FmgrInfo	combinefn;
 
 	int			numFinalArgs;	/* number of arguments to pass to finalfn */
 
@@ -177,6 +179,21 @@ typedef struct WindowStatePerAggData
 
 	int64		transValueCount;	/* number of currently-aggregated rows */
 
+	/*
+	 * Support for evaluating a sliding frame with the combine function, for
+	 * aggregates that have no inverse transition function.  When
+	 * useCombineWindow is set, transValue covers only the rows from
+	 * suffixEnd up to aggregatedupto, and suffixValues[i] holds the
+	 * combined transition value of the rows from suffixStart + i up to
+	 * suffixEnd.  See eval_windowaggregates().
+	 */
+	bool		useCombineWindow;
+	MemoryContext suffixcontext;	/* holds the suffix states */
+	int64		suffixStart;
+	int64		suffixEnd;
+	Datum	   *suffixValues;
+	bool	   *suffixIsNull;
+
 	/* Data local to eval_windowaggregates() */
 	bool		restart;		/* need to restart this agg in this cycle? */
 } WindowStatePerAggData;
@@ -198,6 +215,20 @@ static void finalize_windowaggregate(WindowAggState *winstate,
 						 WindowStatePerFunc perfuncstate,
 						 WindowStatePerAgg peraggstate,
 						 Datum *result, bool *isnull);
+static void combine_windowaggregate(WindowAggState *winstate,
+						WindowStatePerFunc perfuncstate,
+						WindowStatePerAgg peraggstate,
+						MemoryContext aggcontext,
+						Datum *transValue, bool *transValueIsNull,
+						Datum newValue, bool newValueIsNull);
+static void rebuild_windowaggregate_suffix(WindowAggState *winstate,
+							   WindowStatePerFunc perfuncstate,
+							   WindowStatePerAgg peraggstate,
+							   int64 aggregatedupto);
+static void finalize_windowaggregate_combined(WindowAggState *winstate,
+								  WindowStatePerFunc perfuncstate,
+								  WindowStatePerAgg peraggstate,
+								  Datum *result, bool *isnull);
 
 static void eval_windowaggregates(WindowAggState *winstate);
 static void eval_windowfunction(WindowAggState *winstate,
@@ -794,13 +825,255 @@ finalize_windowaggregate(WindowAggState *winstate,
 	MemoryContextSwitchTo(oldContext);
 }
 
+/*
+ * combine_windowaggregate
+ * Combine the transition value 'newValue' into *transValue, using the
+ * aggregate's combine function.
+ *
+ * This is parallel to advance_combine_function in nodeAgg.c.  A pass-by-ref
+ * result is copied into 'aggcontext', which is also the context the combine
+ * function sees through AggCheckCallContext.  'newValue' is not modified.
+ */
+static void
+combine_windowaggregate(WindowAggState *winstate,
+						WindowStatePerFunc perfuncstate,
+						WindowStatePerAgg peraggstate,
+						MemoryContext aggcontext,
+						Datum *transValue, bool *transValueIsNull,
+						Datum newValue, bool newValueIsNull)
+{
+	FunctionCallInfoData fcinfo;
+	MemoryContext oldContext;
+	Datum		newVal;
+
+	if (peraggstate->combinefn.fn_strict)
+	{
+		/* if we're asked to merge a NULL state, then do nothing */
+		if (newValueIsNull)
+			return;
+
+		/*
+		 * Don't call a strict function with a NULL state; just take a copy
+		 * of the other state instead.
+		 */
+		if (*transValueIsNull)
+		{
+			oldContext = MemoryContextSwitchTo(aggcontext);
+			*transValue = datumCopy(newValue,
+									peraggstate->transtypeByVal,
+									peraggstate->transtypeLen);
+			*transValueIsNull = false;
+			MemoryContextSwitchTo(oldContext);
+			return;
+		}
+	}
+
+	/* We run the combine functions in per-input-tuple memory context */
+	oldContext = MemoryContextSwitchTo(winstate->tmpcontext->ecxt_per_tuple_memory);
+
+	InitFunctionCallInfoData(fcinfo, &(peraggstate->combinefn),
+							 2,
+							 perfuncstate->winCollation,
+							 (void *) winstate, NULL);
+	fcinfo.arg[0] = *transValue;
+	fcinfo.argnull[0] = *transValueIsNull;
+	fcinfo.arg[1] = newValue;
+	fcinfo.argnull[1] = newValueIsNull;
+	winstate->curaggcontext = aggcontext;
+	newVal = FunctionCallInvoke(&fcinfo);
+	winstate->curaggcontext = NULL;
+
+	/*
+	 * If pass-by-ref datatype, must copy the new value into aggcontext and
+	 * pfree the prior transValue.  But if the combine function returned a
+	 * pointer to its first input, we don't need to do anything.
+	 */
+	if (!peraggstate->transtypeByVal &&
+		DatumGetPointer(newVal) != DatumGetPointer(*transValue))
+	{
+		if (!fcinfo.isnull)
+		{
+			MemoryContextSwitchTo(aggcontext);
+			newVal = datumCopy(newVal,
+							   peraggstate->transtypeByVal,
+							   peraggstate->transtypeLen);
+		}
+		if (!*transValueIsNull)
+			pfree(DatumGetPointer(*transValue));
+	}
+
+	MemoryContextSwitchTo(oldContext);
+	*transValue = newVal;
+	*transValueIsNull = fcinfo.isnull;
+}
+
+/*
+ * The most rows that rebuild_windowaggregate_suffix() keeps separate suffix
+ * states for.  The suffix states are not charged against the operator's
+ * memory, so if the frame holds more rows than this when the suffix needs
+ * rebuilding, the aggregate is restarted instead, as if it had no combine
+ * function.
+ */
+#define WINDOW_COMBINE_MAX_SUFFIX	1024
+
+/*
+ * rebuild_windowaggregate_suffix
+ * Rebuild the suffix states of an aggregate that uses the combine function
+ * to evaluate a sliding frame.
+ *
+ * On entry, the aggregate's transValue covers the rows from suffixEnd up to
+ * 'aggregatedupto', and the frame head has moved past suffixEnd.  We re-read
+ * the rows from the frame head onwards, compute a transition value for each
+ * of them on its own, and fold those together from the back with the combine
+ * function, so that suffixValues[i] covers the rows from frameheadpos + i up
+ * to 'aggregatedupto'.  Then transValue is re-initialized to cover no rows.
+ *
+ * Each row is thus passed to the transition function at most twice and to
+ * the combine function at most twice, however far the frame extends.
+ */
+static void
+rebuild_windowaggregate_suffix(WindowAggState *winstate,
+							   WindowStatePerFunc perfuncstate,
+							   WindowStatePerAgg peraggstate,
+							   int64 aggregatedupto)
+{
+	TupleTableSlot *slot = winstate->temp_slot_1;
+	MemoryContext suffixcontext = peraggstate->suffixcontext;
+	MemoryContext aggcontext = peraggstate->aggcontext;
+	int64		start = winstate->frameheadpos;
+	int64		nrows = aggregatedupto - start;
+	int64		i;
+
+	Assert(nrows > 0 && nrows <= WINDOW_COMBINE_MAX_SUFFIX);
+
+	MemoryContextResetAndDeleteChildren(suffixcontext);
+	peraggstate->suffixValues = (Datum *)
+		MemoryContextAlloc(suffixcontext, nrows * sizeof(Datum));
+	peraggstate->suffixIsNull = (bool *)
+		MemoryContextAlloc(suffixcontext, nrows * sizeof(bool));
+
+	/*
+	 * Compute the transition value of each row.  We borrow the transValue
+	 * fields for this, with aggcontext pointing to the suffix context so that
+	 * advance_windowaggregate() leaves the per-row states there.
+	 */
+	peraggstate->aggcontext = suffixcontext;
+	for (i = 0; i < nrows; i++)
+	{
+		if (!window_gettupleslot(winstate->agg_winobj, start + i, slot))
+			elog(ERROR, "could not re-fetch previously fetched frame row");
+
+		/* Set tuple context for evaluation of aggregate arguments */
+		winstate->tmpcontext->ecxt_outertuple = slot;
+
+		if (peraggstate->initValueIsNull)
+			peraggstate->transValue = peraggstate->initValue;
+		else
+		{
+			MemoryContext oldContext = MemoryContextSwitchTo(suffixcontext);
+
+			peraggstate->transValue = datumCopy(peraggstate->initValue,
+												peraggstate->transtypeByVal,
+												peraggstate->transtypeLen);
+			MemoryContextSwitchTo(oldContext);
+		}
+		peraggstate->transValueIsNull = peraggstate->initValueIsNull;
+		peraggstate->transValueCount = 0;
+
+		advance_windowaggregate(winstate, perfuncstate, peraggstate);
+
+		peraggstate->suffixValues[i] = peraggstate->transValue;
+		peraggstate->suffixIsNull[i] = peraggstate->transValueIsNull;
+
+		ResetExprContext(winstate->tmpcontext);
+		ExecClearTuple(slot);
+	}
+	peraggstate->aggcontext = aggcontext;
+
+	/* Fold the states together, starting from the last row */
+	for (i = nrows - 2; i >= 0; i--)
+	{
+		combine_windowaggregate(winstate, perfuncstate, peraggstate,
+								suffixcontext,
+								&peraggstate->suffixValues[i],
+								&peraggstate->suffixIsNull[i],
+								peraggstate->suffixValues[i + 1],
+								peraggstate->suffixIsNull[i + 1]);
+		ResetExprContext(winstate->tmpcontext);
+	}
+
+	peraggstate->suffixStart = start;
+	peraggstate->suffixEnd = aggregatedupto;
+
+	/* The suffix states now cover all the rows transValue did */
+	initialize_windowaggregate(winstate, perfuncstate, peraggstate);
+}
+
+/*
+ * finalize_windowaggregate_combined
+ * Like finalize_windowaggregate, for an aggregate using the combine function
+ * whose frame begins within its suffix states.
+ *
+ * The transition value for the whole frame is the suffix state at the frame
+ * head, combined with transValue.  It is built in the per-input-tuple memory
+ * context, and only lives until the final function has been applied.
+ */
+static void
+finalize_windowaggregate_combined(WindowAggState *winstate,
+								  WindowStatePerFunc perfuncstate,
+								  WindowStatePerAgg peraggstate,
+								  Datum *result, bool *isnull)
+{
+	MemoryContext tmpcontext = winstate->tmpcontext->ecxt_per_tuple_memory;
+	int64		i = winstate->frameheadpos - peraggstate->suffixStart;
+	Datum		saveValue = peraggstate->transValue;
+	bool		saveValueIsNull = peraggstate->transValueIsNull;
+	Datum		value;
+	bool		valueIsNull;
+
+	Assert(i >= 0 && winstate->frameheadpos < peraggstate->suffixEnd);
+
+	/* Start from the initial value, like nodeAgg.c does when combining */
+	if (peraggstate->initValueIsNull)
+		value = peraggstate->initValue;
+	else
+	{
+		MemoryContext oldContext = MemoryContextSwitchTo(tmpcontext);
+
+		value = datumCopy(peraggstate->initValue,
+						  peraggstate->transtypeByVal,
+						  peraggstate->transtypeLen);
+		MemoryContextSwitchTo(oldContext);
+	}
+	valueIsNull = peraggstate->initValueIsNull;
+
+	combine_windowaggregate(winstate, perfuncstate, peraggstate, tmpcontext,
+							&value, &valueIsNull,
+							peraggstate->suffixValues[i],
+							peraggstate->suffixIsNull[i]);
+	if (peraggstate->transValueCount > 0)
+		combine_windowaggregate(winstate, perfuncstate, peraggstate, tmpcontext,
+								&value, &valueIsNull,
+								saveValue, saveValueIsNull);
+
+	peraggstate->transValue = value;
+	peraggstate->transValueIsNull = valueIsNull;
+	finalize_windowaggregate(winstate, perfuncstate, peraggstate,
+							 result, isnull);
+	peraggstate->transValue = saveValue;
+	peraggstate->transValueIsNull = saveValueIsNull;
+
+	ResetExprContext(winstate->tmpcontext);
+}
+
 /*
  * eval_windowaggregates
  * evaluate plain aggregates being used as window functions
  *
  * This differs from nodeAgg.c in two ways.  First, if the window's frame
  * start position moves, we use the inverse transition function (if it exists)
- * to remove rows from the transition value.  And second, we expect to be
+ * to remove rows from the transition value, or failing that, the combine
+ * function to piece the frame together.  And second, we expect to be
  * able to call aggregate final functions repeatedly after aggregating more
  * data onto the same transition value.  This is not a behavior required by
  * nodeAgg.c.
@@ -812,6 +1085,7 @@ eval_windowaggregates(WindowAggState *winstate)
 	int			wfuncno,
 				numaggs,
 				numaggs_restart,
+				numaggs_invertible,
 				i;
 	int64		aggregatedupto_nonrestarted;
 	MemoryContext oldContext;
@@ -860,6 +1134,18 @@ eval_windowaggregates(WindowAggState *winstate)
 	 * must perform the aggregation all over again for all tuples within the
 	 * new frame boundaries.
 	 *
+	 * An aggregate without an inverse transition function can still avoid
+	 * that, if it has a combine function.  We then keep the frame in two
+	 * parts: a run of "suffix" transition values, each covering the rows
+	 * from some position up to a fixed point, and the usual running
+	 * transition value covering the rows from that point on.  The frame's
+	 * value is the suffix value at the frame head combined with the running
+	 * value.  When the frame head moves past the fixed point, the suffix
+	 * values are rebuilt from the rows of the running value.  This costs a
+	 * constant number of transition and combine calls per row, rather than
+	 * one transition call per row in the frame.  Frames that are too wide to
+	 * keep a suffix value per row restart as usual.
+	 *
 	 * In many common cases, multiple rows share the same frame and hence the
 	 * same aggregate value. (In particular, if there's no ORDER BY in a RANGE
 	 * window, then all rows are peers and so they all have window frame equal
@@ -966,7 +1252,7 @@ eval_windowaggregates(WindowAggState *winstate)
 	 * We restart the aggregation:
 	 *	 - if we're processing the first row in the partition, or
 	 *	 - if the frame's head moved and we cannot use an inverse
-	 *	   transition function, or
+	 *	   transition function or the combine function, or
 	 *	 - if the new frame doesn't overlap the old one
 	 *
 	 * Note that we don't strictly need to restart in the last case, but if
@@ -975,12 +1261,18 @@ eval_windowaggregates(WindowAggState *winstate)
 	 *----------
 	 */
 	numaggs_restart = 0;
+	numaggs_invertible = 0;
 	for (i = 0; i < numaggs; i++)
 	{
 		peraggstate = &winstate->peragg[i];
 		if (winstate->currentpos == 0 ||
 			(winstate->aggregatedbase != winstate->frameheadpos &&
-			 !OidIsValid(peraggstate->invtransfn_oid)) ||
+			 !OidIsValid(peraggstate->invtransfn_oid) &&
+			 !peraggstate->useCombineWindow) ||
+			(peraggstate->useCombineWindow &&
+			 winstate->frameheadpos > peraggstate->suffixEnd &&
+			 winstate->aggregatedupto - winstate->frameheadpos >
+			 WINDOW_COMBINE_MAX_SUFFIX) ||
 			winstate->aggregatedupto <= winstate->frameheadpos ||
 			frame_head_moved_backwards ||
 			frame_tail_moved_backwards)
@@ -989,7 +1281,11 @@ eval_windowaggregates(WindowAggState *winstate)
 			numaggs_restart++;
 		}
 		else
+		{
 			peraggstate->restart = false;
+			if (!peraggstate->useCombineWindow)
+				numaggs_invertible++;
+		}
 	}
 
 	/*
@@ -997,9 +1293,10 @@ eval_windowaggregates(WindowAggState *winstate)
 	 * aggregatedbase to match the frame's head by removing input rows that
 	 * fell off the top of the frame from the aggregations.  This can fail,
 	 * i.e. advance_windowaggregate_base() can return false, in which case
-	 * we'll restart that aggregate below.
+	 * we'll restart that aggregate below.  Aggregates using the combine
+	 * function don't remove rows one at a time; they are dealt with below.
 	 */
-	while (numaggs_restart < numaggs &&
+	while (numaggs_invertible > 0 &&
 		   winstate->aggregatedbase < winstate->frameheadpos)
 	{
 		/*
@@ -1022,7 +1319,7 @@ eval_windowaggregates(WindowAggState *winstate)
 			bool		ok;
 
 			peraggstate = &winstate->peragg[i];
-			if (peraggstate->restart)
+			if (peraggstate->restart || peraggstate->useCombineWindow)
 				continue;
 
 			wfuncno = peraggstate->wfuncno;
@@ -1034,6 +1331,7 @@ eval_windowaggregates(WindowAggState *winstate)
 				/* Inverse transition function has failed, must restart */
 				peraggstate->restart = true;
 				numaggs_restart++;
+				numaggs_invertible--;
 			}
 		}
 
@@ -1086,6 +1384,12 @@ eval_windowaggregates(WindowAggState *winstate)
 			initialize_windowaggregate(winstate,
 									   &winstate->perfunc[wfuncno],
 									   peraggstate);
+			if (peraggstate->useCombineWindow)
+			{
+				MemoryContextResetAndDeleteChildren(peraggstate->suffixcontext);
+				peraggstate->suffixStart = winstate->frameheadpos;
+				peraggstate->suffixEnd = winstate->frameheadpos;
+			}
 		}
 		else if (!peraggstate->resultValueIsNull)
 		{
@@ -1096,6 +1400,28 @@ eval_windowaggregates(WindowAggState *winstate)
 		}
 	}
 
+	/*
+	 * Aggregates using the combine function keep the rows from frame head up
+	 * to suffixEnd in their suffix states, and the rest in transValue.  If
+	 * the frame head has moved past suffixEnd, the suffix states are of no
+	 * more use, so move the rows in transValue that are still in the frame
+	 * over to a new set of suffix states.  The rows that fell off the top of
+	 * the frame are thereby dropped.
+	 */
+	for (i = 0; i < numaggs; i++)
+	{
+		peraggstate = &winstate->peragg[i];
+		if (peraggstate->useCombineWindow && !peraggstate->restart &&
+			winstate->frameheadpos > peraggstate->suffixEnd)
+		{
+			wfuncno = peraggstate->wfuncno;
+			rebuild_windowaggregate_suffix(winstate,
+										   &winstate->perfunc[wfuncno],
+										   peraggstate,
+										   winstate->aggregatedupto);
+		}
+	}
+
 	/*
 	 * Non-restarted aggregates now contain the rows between aggregatedbase
 	 * (i.e., frameheadpos) and aggregatedupto, while restarted aggregates
@@ -1183,10 +1509,17 @@ eval_windowaggregates(WindowAggState *winstate)
 		wfuncno = peraggstate->wfuncno;
 		result = &econtext->ecxt_aggvalues[wfuncno];
 		isnull = &econtext->ecxt_aggnulls[wfuncno];
-		finalize_windowaggregate(winstate,
-								 &winstate->perfunc[wfuncno],
-								 peraggstate,
-								 result, isnull);
+		if (peraggstate->useCombineWindow &&
+			winstate->frameheadpos < peraggstate->suffixEnd)
+			finalize_windowaggregate_combined(winstate,
+											  &winstate->perfunc[wfuncno],
+											  peraggstate,
+											  result, isnull);
+		else
+			finalize_windowaggregate(winstate,
+									 &winstate->perfunc[wfuncno],
+									 peraggstate,
+									 result, isnull);
 
 		/*
 		 * save the result in case next row shares the same frame.
@@ -1479,6 +1812,8 @@ release_partition(WindowAggState *winstate)
 	{
 		if (winstate->peragg[i].aggcontext != winstate->aggcontext)
 			MemoryContextResetAndDeleteChildren(winstate->peragg[i].aggcontext);
+		if (winstate->peragg[i].suffixcontext)
+			MemoryContextResetAndDeleteChildren(winstate->peragg[i].suffixcontext);
 	}
 
 	if (winstate->buffer)
@@ -2232,6 +2567,12 @@ ExecInitWindowAgg(WindowAgg *node, EState *estate, int eflags)
 		winstate->ordEqfunctions = execTuplesMatchPrepare(node->ordNumCols,
 														  node->ordOperators);
 
+	/*
+	 * Copy frame options to state node for easy access.  initialize_peragg()
+	 * looks at them, so this must be done first.
+	 */
+	winstate->frameOptions = node->frameOptions;
+
 	/*
 	 * WindowAgg nodes use aggvalues and aggnulls as well as Agg nodes.
 	 */
@@ -2349,9 +2690,6 @@ ExecInitWindowAgg(WindowAgg *node, EState *estate, int eflags)
 		winstate->agg_winobj = agg_winobj;
 	}
 
-	/* copy frame options to state node for easy access */
-	winstate->frameOptions = node->frameOptions;
-
 	/* initialize frame bound offset expressions */
 	winstate->startOffset = ExecInitExpr((Expr *) node->startOffset,
 										 (PlanState *) winstate);
@@ -2581,6 +2919,8 @@ ExecEndWindowAgg(WindowAggState *node)
 	{
 		if (node->peragg[i].aggcontext != node->aggcontext)
 			MemoryContextDelete(node->peragg[i].aggcontext);
+		if (node->peragg[i].suffixcontext)
+			MemoryContextDelete(node->peragg[i].suffixcontext);
 	}
 	MemoryContextDelete(node->partcontext);
 	MemoryContextDelete(node->aggcontext);
@@ -2654,11 +2994,13 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 	AclResult	aclresult;
 	Oid			transfn_oid,
 				invtransfn_oid,
-				finalfn_oid;
+				finalfn_oid,
+				combinefn_oid;
 	bool		finalextra;
 	Expr	   *transfnexpr,
 			   *invtransfnexpr,
-			   *finalfnexpr;
+			   *finalfnexpr,
+			   *combinefnexpr;
 	Datum		textInitVal;
 	int			i;
 	ListCell   *lc;
@@ -2708,6 +3050,21 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 		initvalAttNo = Anum_pg_aggregate_agginitval;
 	}
 
+	/*
+	 * Without an inverse transition function, we can still evaluate a moving
+	 * frame incrementally if the aggregate has a combine function.  The same
+	 * restrictions apply as for the moving-aggregate implementation, and
+	 * DISTINCT is not supported.
+	 */
+	if (!OidIsValid(invtransfn_oid) &&
+		OidIsValid(aggform->aggcombinefn) &&
+		!wfunc->windistinct &&
+		!(winstate->frameOptions & FRAMEOPTION_START_UNBOUNDED_PRECEDING) &&
+		!contain_volatile_functions((Node *) wfunc))
+		peraggstate->combinefn_oid = combinefn_oid = aggform->aggcombinefn;
+	else
+		peraggstate->combinefn_oid = combinefn_oid = InvalidOid;
+
 	/*
 	 * ExecInitWindowAgg already checked permission to call aggregate function
 	 * ... but we still need to check the component functions
@@ -2752,6 +3109,16 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 							   get_func_name(finalfn_oid));
 			InvokeFunctionExecuteHook(finalfn_oid);
 		}
+
+		if (OidIsValid(combinefn_oid))
+		{
+			aclresult = pg_proc_aclcheck(combinefn_oid, aggOwner,
+										 ACL_EXECUTE);
+			if (aclresult != ACLCHECK_OK)
+				aclcheck_error(aclresult, ACL_KIND_PROC,
+							   get_func_name(combinefn_oid));
+			InvokeFunctionExecuteHook(combinefn_oid);
+		}
 	}
 
 	/* Detect how many arguments to pass to the finalfn */
@@ -2801,6 +3168,16 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 		fmgr_info_set_expr((Node *) finalfnexpr, &peraggstate->finalfn);
 	}
 
+	if (OidIsValid(combinefn_oid))
+	{
+		build_aggregate_combinefn_expr(aggtranstype,
+									   wfunc->inputcollid,
+									   combinefn_oid,
+									   &combinefnexpr);
+		fmgr_info(combinefn_oid, &peraggstate->combinefn);
+		fmgr_info_set_expr((Node *) combinefnexpr, &peraggstate->combinefn);
+	}
+
 	/* get info about relevant datatypes */
 	get_typlenbyval(wfunc->wintype,
 					&peraggstate->resulttypeLen,
@@ -2886,6 +3263,19 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 				(errcode(ERRCODE_INVALID_FUNCTION_DEFINITION),
 				 errmsg("strictness of aggregate's forward and inverse transition functions must match")));
 
+	/*
+	 * A strict combine function must be able to start from a copy of the
+	 * other state, which is impossible for INTERNAL states.  nodeAgg.c
+	 * rejects such aggregates in partial aggregation; we just don't use the
+	 * combine function for them.  Nor do we use it for frames that extend to
+	 * the end of the partition: the suffix states would then cover the rest
+	 * of the partition every time the frame head moves.
+	 */
+	peraggstate->useCombineWindow =
+		OidIsValid(combinefn_oid) &&
+		!(winstate->frameOptions & FRAMEOPTION_END_UNBOUNDED_FOLLOWING) &&
+		!(peraggstate->combinefn.fn_strict && aggtranstype == INTERNALOID);
+
 	/*
 	 * Moving aggregates use their own aggcontext.
 	 *
@@ -2900,7 +3290,7 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 	 * they have historically been for plain aggregates, but that seems grotty
 	 * and likely to lead to memory leaks.
 	 */
-	if (OidIsValid(invtransfn_oid))
+	if (OidIsValid(invtransfn_oid) || peraggstate->useCombineWindow)
 		peraggstate->aggcontext =
 			AllocSetContextCreate(CurrentMemoryContext,
 								  "WindowAgg_AggregatePrivate",
@@ -2910,6 +3300,19 @@ initialize_peragg(WindowAggState *winstate, WindowFunc *wfunc,
 	else
 		peraggstate->aggcontext = winstate->aggcontext;
 
+	/* The suffix states of a combine-window aggregate live separately */
+	if (peraggstate->useCombineWindow)
+		peraggstate->suffixcontext =
+			AllocSetContextCreate(CurrentMemoryContext,
+								  "WindowAgg_AggregateSuffix",
+								  ALLOCSET_DEFAULT_MINSIZE,
+								  ALLOCSET_DEFAULT_INITSIZE,
+								  ALLOCSET_DEFAULT_MAXSIZE);
+	else
+		peraggstate->suffixcontext = NULL;
+	peraggstate->suffixStart = 0;
+	peraggstate->suffixEnd = 0;
+
 	ReleaseSysCache(aggTuple);
 
 	return peraggstate;
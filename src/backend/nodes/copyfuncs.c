@@ -1124,6 +1124,7 @@ _copySort(const Sort *from)
 
     /* CDB */
 	COPY_SCALAR_FIELD(noduplicates);
+	COPY_SCALAR_FIELD(numPresortedCols);
 
 	COPY_SCALAR_FIELD(share_type);
 	COPY_SCALAR_FIELD(share_id);
@@ -466,6 +466,7 @@ _outSort(StringInfo str, Sort *node)
 
     /* CDB */
     WRITE_BOOL_FIELD(noduplicates);
+	WRITE_INT_FIELD(numPresortedCols);
 
 	WRITE_ENUM_FIELD(share_type, ShareType);
 	WRITE_INT_FIELD(share_id);
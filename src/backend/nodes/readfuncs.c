@@ -3059,6 +3059,7 @@ _readSort(void)
 
     /* CDB */
 	READ_BOOL_FIELD(noduplicates);
+	READ_INT_FIELD(numPresortedCols);
 
 	READ_ENUM_FIELD(share_type, ShareType);
 	READ_INT_FIELD(share_id);
@@ -655,6 +655,29 @@ pathkeys_contained_in(List *keys1, List *keys2)
 	return false;
 }
 
+/*
+ * pathkeys_common
+ *	  Returns the number of leading pathkeys that keys1 and keys2 have in
+ *	  common.  A path ordered by keys2 is then also ordered by that many
+ *	  leading keys of keys1.
+ */
+int
+pathkeys_common(List *keys1, List *keys2)
+{
+	int			n = 0;
+	ListCell   *key1,
+			   *key2;
+
+	/* As in compare_pathkeys, canonical pathkeys can be compared by pointer */
+	forboth(key1, keys1, key2, keys2)
+	{
+		if (lfirst(key1) != lfirst(key2))
+			break;
+		n++;
+	}
+	return n;
+}
+
 /*
  * get_cheapest_path_for_pathkeys
  *	  Find the cheapest path (according to the specified criterion) that
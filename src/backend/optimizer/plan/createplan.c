@@ -1620,6 +1620,16 @@ create_sort_plan(PlannerInfo *root, SortPath *best_path, int flags)
 	plan = make_sort_from_pathkeys(subplan, best_path->path.pathkeys,
 								   false /* GPDB_96_MERGE_FIXME: is 'false' correct here? */);
 
+	/*
+	 * Remember how many leading sort keys the input is already ordered by.
+	 * With a LIMIT, the executor can use that to stop reading the input
+	 * early.  This is only reliable if there is one sort column for each
+	 * pathkey; make_sort_from_pathkeys() skips redundant ones.
+	 */
+	if (plan->numCols == list_length(best_path->path.pathkeys))
+		plan->numPresortedCols = pathkeys_common(best_path->path.pathkeys,
+												 best_path->subpath->pathkeys);
+
 	copy_generic_path_info(&plan->plan, (Path *) best_path);
 
 	return plan;
@@ -6059,6 +6069,7 @@ make_sort(Plan *lefttree, int numCols,
 	Assert(sortColIdx[0] != 0);
 
 	node->noduplicates = false; /* CDB */
+	node->numPresortedCols = 0;
 
 	node->share_type = SHARE_NOTSHARED;
 	node->share_id = SHARE_ID_NOT_SHARED;
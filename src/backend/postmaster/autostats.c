@@ -39,7 +39,7 @@
  * Forward declarations.
  */
 static void autostats_issue_analyze(Oid relationOid);
-static bool autostats_on_change_check(AutoStatsCmdType cmdType, uint64 ntuples);
+static bool autostats_on_change_check(AutoStatsCmdType cmdType, Oid relationOid, uint64 ntuples);
 static bool autostats_on_no_stats_check(AutoStatsCmdType cmdType, Oid relationOid);
 
 /*
@@ -80,9 +80,14 @@ autostats_issue_analyze(Oid relationOid)
  * Method determines if auto-stats should run as per onchange auto-stats policy. This policy
  * enables auto-analyze if the command was a CTAS, INSERT, DELETE, UPDATE or COPY
  * and the number of tuples is greater than a threshold.
+ *
+ * If gp_autostats_on_change_scale_factor is set, the number of tuples must also
+ * exceed that fraction of the table's reltuples. A load that appends a small
+ * slice to a large table barely moves its statistics, so it is not worth
+ * holding up the loading statement with an ANALYZE.
  */
 static bool
-autostats_on_change_check(AutoStatsCmdType cmdType, uint64 ntuples)
+autostats_on_change_check(AutoStatsCmdType cmdType, Oid relationOid, uint64 ntuples)
 {
 	bool		result = false;
 
@@ -100,6 +105,26 @@ autostats_on_change_check(AutoStatsCmdType cmdType, uint64 ntuples)
 	}
 
 	result = result && (ntuples > gp_autostats_on_change_threshold);
+
+	if (result && gp_autostats_on_change_scale_factor > 0)
+	{
+		HeapTuple	tuple;
+		float4		reltuples;
+
+		tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(relationOid));
+		if (!HeapTupleIsValid(tuple))
+			elog(ERROR, "cache lookup failed for relation %u", relationOid);
+		reltuples = ((Form_pg_class) GETSTRUCT(tuple))->reltuples;
+		ReleaseSysCache(tuple);
+
+		elog(DEBUG5, "Auto-stats ONCHANGE check on tableoid %d has reltuples = %.0f, scale factor = %g.",
+			 relationOid,
+			 reltuples,
+			 gp_autostats_on_change_scale_factor);
+
+		result = ((double) ntuples > gp_autostats_on_change_scale_factor * reltuples);
+	}
+
 	return result;
 }
 
@@ -309,7 +334,7 @@ auto_stats(AutoStatsCmdType cmdType, Oid relationOid, uint64 ntuples, bool inFun
 	switch (actual_gp_autostats_mode)
 	{
 		case GP_AUTOSTATS_ON_CHANGE:
-			policyCheck = autostats_on_change_check(cmdType, ntuples);
+			policyCheck = autostats_on_change_check(cmdType, relationOid, ntuples);
 			break;
 		case GP_AUTOSTATS_ON_NO_STATS:
 			policyCheck = autostats_on_no_stats_check(cmdType, relationOid);
@@ -129,6 +129,14 @@ struct BufFile
 	 */
 	size_t		uncompressed_bytes;
 
+	/*
+	 * The first BUFFILE_COMPRESSION_SAMPLE_SIZE bytes written are collected
+	 * here, before anything is written to disk, to decide whether the data
+	 * is worth compressing. NULL once the decision has been made.
+	 */
+	char	   *sample_buffer;
+	int			sample_len;
+
 	/* This holds compressed input, during decompression. */
 	ZSTD_inBuffer compressed_buffer;
 	bool		decompression_finished;
@@ -323,6 +331,8 @@ BufFileClose(BufFile *file)
 
 	/* release zstd handles */
 #ifdef HAVE_LIBZSTD
+	if (file->sample_buffer)
+		pfree(file->sample_buffer);
 	if (file->zstd_context)
 		zstd_free_context(file->zstd_context);
 #endif
@@ -705,6 +715,8 @@ BufFileSeek(BufFile *file, int fileno, off_t offset, int whence)
 			if (fileno != 0 || offset != 0 || whence != SEEK_SET)
 				elog(ERROR, "invalid seek in sequential BufFile");
 			BufFileEndCompression(file);
+			if (file->state == BFS_RANDOM_ACCESS)
+				break;		/* compression was abandoned, see BufFileDecideCompression */
 			file->offset = 0;
 			file->pos = 0;
 			file->nbytes = 0;
@@ -798,6 +810,25 @@ BufFileSeekBlock(BufFile *file, int64 blknum)
 	return BufFileSeek(file, 0 /* fileno */, blknum * BLCKSZ, SEEK_SET);
 }
 
+/*
+ * BufFilePrefetchBlock --- hint that the n'th BLCKSZ-sized block will be
+ * read soon
+ *
+ * This only issues an asynchronous read-ahead request to the kernel; the
+ * logical position and the buffer are not affected. It's a no-op for
+ * sequential BufFiles, whose contents may be compressed.
+ */
+void
+BufFilePrefetchBlock(BufFile *file, int64 blknum)
+{
+#ifdef USE_PREFETCH
+	if (file->state != BFS_RANDOM_ACCESS)
+		return;
+
+	(void) FilePrefetch(file->file, blknum * BLCKSZ, BLCKSZ);
+#endif
+}
+
 /*
  * BufFileUpdateSize
  *
@@ -862,7 +893,10 @@ BufFileSuspend(BufFile *buffile)
 		case BFS_SEQUENTIAL_WRITING:
 			break;
 		case BFS_COMPRESSED_WRITING:
-			return BufFileEndCompression(buffile);
+			BufFileEndCompression(buffile);
+			if (buffile->state == BFS_RANDOM_ACCESS)
+				break;		/* compression was abandoned, see BufFileDecideCompression */
+			return;
 
 		case BFS_SEQUENTIAL_READING:
 		case BFS_COMPRESSED_READING:
@@ -923,13 +957,14 @@ bool gp_workfile_compression;		/* GUC */
  *
  * Trying to do arbitrary seeks
  *
- * A sequential file that is to be passed between processes, using
- * BufFileCreateNamedTemp/BufFileOpenNamedTemp(), can also be used in
- * sequential mode. If the file was pledged as sequential when creating
- * it, the reading side must also pledge sequential access after calling
- * BufFileOpenNamedTemp(). Otherwise, the reader might try to read a
- * compressed file as uncompressed. (As of this writing, none of the callers
- * that use buffiles across processes pledge sequential access, though.)
+ * A sequential file cannot be passed between processes, using
+ * BufFileCreateNamedTemp/BufFileOpenNamedTemp(). Whether the file is
+ * compressed is only decided while it's being written, after looking at
+ * the first few kB of data (see BufFileDecideCompression()), and the
+ * decision is not recorded in the file itself. The reading process would
+ * have no way to tell whether it's reading a compressed file or not. None
+ * of the callers that use buffiles across processes pledge sequential
+ * access.
  */
 void
 BufFilePledgeSequential(BufFile *buffile)
@@ -948,6 +983,17 @@ BufFilePledgeSequential(BufFile *buffile)
 
 #define BUFFILE_ZSTD_COMPRESSION_LEVEL 1
 
+/*
+ * Compression is only kept up if the first BUFFILE_COMPRESSION_SAMPLE_SIZE
+ * bytes of the file shrink to less than BUFFILE_COMPRESSION_MIN_RATIO of
+ * their original size. Spilled tuples that are mostly already-compressed
+ * toast data, or random bytes like UUIDs, don't gain enough to pay for the
+ * CPU time, and the zstd context is a sizeable chunk of memory to hold on
+ * to for every batch file.
+ */
+#define BUFFILE_COMPRESSION_SAMPLE_SIZE		(2 * BLCKSZ)
+#define BUFFILE_COMPRESSION_MIN_RATIO		0.9
+
 /*
  * Temporary buffer used during compression. It's used only within the
  * functions, so we can allocate this once and reuse it for all files.
@@ -964,15 +1010,12 @@ BufFileStartCompression(BufFile *file)
 
 	/*
 	 * When working with compressed files, we rely on libzstd's buffer,
-	 * and the BufFile's own buffer is unused. It's a bit silly that we
-	 * allocate it in makeBufFile(), just to free it here again, but it
-	 * doesn't seem worth the trouble to avoid that either.
+	 * and the BufFile's own buffer is unused. We keep it around until
+	 * BufFileDecideCompression() has looked at the sample, though, in case
+	 * we fall back to writing the file uncompressed.
 	 */
-	if (file->buffer)
-	{
-		pfree(file->buffer);
-		file->buffer = NULL;
-	}
+	file->sample_buffer = palloc(BUFFILE_COMPRESSION_SAMPLE_SIZE);
+	file->sample_len = 0;
 
 	if (compression_buffer == NULL)
 		compression_buffer = MemoryContextAlloc(TopMemoryContext, BLCKSZ);
@@ -997,6 +1040,89 @@ BufFileStartCompression(BufFile *file)
 	file->state = BFS_COMPRESSED_WRITING;
 }
 
+/*
+ * Compress the sample collected at the beginning of the file, and decide
+ * whether to continue with compression.
+ *
+ * If the sample compresses well, the compressed sample is written out and
+ * the file continues in BFS_COMPRESSED_WRITING state. Otherwise the zstd
+ * stream is thrown away, and the sample is written out as is, and the file
+ * becomes a plain BFS_RANDOM_ACCESS file, just like it would have been
+ * with gp_workfile_compression=off. Nothing has been written to disk before
+ * this, and the file is only read back through this same BufFile, so
+ * there's no need to mark the switch in the file itself.
+ */
+static void
+BufFileDecideCompression(BufFile *file)
+{
+	ZSTD_inBuffer input;
+	ZSTD_outBuffer output;
+	size_t		ret;
+	char	   *sample = file->sample_buffer;
+	int			sample_len = file->sample_len;
+
+	Assert(file->state == BFS_COMPRESSED_WRITING);
+	Assert(sample != NULL);
+
+	file->sample_buffer = NULL;
+	file->sample_len = 0;
+
+	/*
+	 * Compress the whole sample into memory in one go, so that we can still
+	 * back out. ZSTD_compressBound() is enough for the data, plus the block
+	 * headers that ZSTD_flushStream() adds.
+	 */
+	output.size = ZSTD_compressBound(sample_len);
+	output.dst = palloc(output.size);
+	output.pos = 0;
+
+	input.src = sample;
+	input.size = sample_len;
+	input.pos = 0;
+
+	ret = ZSTD_compressStream(file->zstd_context->cctx, &output, &input);
+	if (ZSTD_isError(ret))
+		elog(ERROR, "%s", ZSTD_getErrorName(ret));
+	ret = ZSTD_flushStream(file->zstd_context->cctx, &output);
+	if (ZSTD_isError(ret))
+		elog(ERROR, "%s", ZSTD_getErrorName(ret));
+	if (ret != 0 || input.pos != input.size)
+		elog(ERROR, "could not compress sample of temporary file in one pass");
+
+	if (output.pos < sample_len * BUFFILE_COMPRESSION_MIN_RATIO)
+	{
+		int			wrote;
+
+		wrote = FileWrite(file->file, output.dst, output.pos);
+		if (wrote != output.pos)
+			elog(ERROR, "could not write %d bytes to compressed temporary file: %m", (int) output.pos);
+		file->maxoffset += wrote;
+
+		/* Committed to compression. The BufFile's own buffer is unused. */
+		if (file->buffer)
+		{
+			pfree(file->buffer);
+			file->buffer = NULL;
+		}
+	}
+	else
+	{
+		elog(DEBUG1, "BufFile sample compressed only from %d to %d bytes, writing it uncompressed",
+			 sample_len, (int) output.pos);
+
+		ZSTD_freeCCtx(file->zstd_context->cctx);
+		file->zstd_context->cctx = NULL;
+		file->uncompressed_bytes = 0;
+
+		file->state = BFS_RANDOM_ACCESS;
+		if (sample_len > 0)
+			BufFileWrite(file, sample, sample_len);
+	}
+
+	pfree(output.dst);
+	pfree(sample);
+}
+
 static void
 BufFileDumpCompressedBuffer(BufFile *file, const void *buffer, Size nbytes)
 {
@@ -1004,6 +1130,29 @@ BufFileDumpCompressedBuffer(BufFile *file, const void *buffer, Size nbytes)
 
 	file->uncompressed_bytes += nbytes;
 
+	/* Still collecting the sample? */
+	if (file->sample_buffer)
+	{
+		Size		nsample;
+
+		nsample = Min(nbytes, BUFFILE_COMPRESSION_SAMPLE_SIZE - file->sample_len);
+		memcpy(file->sample_buffer + file->sample_len, buffer, nsample);
+		file->sample_len += nsample;
+		buffer = (const char *) buffer + nsample;
+		nbytes -= nsample;
+
+		if (file->sample_len < BUFFILE_COMPRESSION_SAMPLE_SIZE)
+			return;
+
+		BufFileDecideCompression(file);
+		if (file->state != BFS_COMPRESSED_WRITING)
+		{
+			if (nbytes > 0)
+				BufFileWrite(file, buffer, nbytes);
+			return;
+		}
+	}
+
 	/*
 	 * Call ZSTD_compressStream() until all the input has been consumed.
 	 */
@@ -1047,6 +1196,18 @@ BufFileEndCompression(BufFile *file)
 
 	Assert(file->state == BFS_COMPRESSED_WRITING);
 
+	/*
+	 * If the whole file fit in the sample, we haven't decided yet whether
+	 * to compress it. If we decide not to, we're done here: the file is now
+	 * a regular uncompressed file, and the caller will deal with it as such.
+	 */
+	if (file->sample_buffer)
+	{
+		BufFileDecideCompression(file);
+		if (file->state != BFS_COMPRESSED_WRITING)
+			return;
+	}
+
 	do {
 		output.dst = compression_buffer;
 		output.size = BLCKSZ;
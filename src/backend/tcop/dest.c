@@ -247,6 +247,7 @@ ReadyForQuery(CommandDest dest)
 
 					pq_beginmessage(&buf, 'x');
 					pq_sendbyte(&buf, TransactionDidWriteXLog());
+					pq_sendbyte(&buf, TransactionIdIsValid(GetTopTransactionIdIfAny()));
 					pq_endmessage(&buf);
 				}
 
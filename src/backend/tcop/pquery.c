@@ -114,6 +114,9 @@ CreateQueryDesc(PlannedStmt *plannedstmt,
 	qd->portal_name = NULL;
 
 	qd->ddesc = NULL;
+	qd->dispatchedStmt = NULL;
+	qd->serializedPlan = NULL;
+	qd->serializedPlanLen = 0;
 	qd->memoryAccountId = MEMORY_OWNER_TYPE_Undefined;
 	
 	if (Gp_role != GP_ROLE_EXECUTE)
@@ -153,6 +156,10 @@ CreateUtilityQueryDesc(Node *utilitystmt,
 	qd->extended_query = false; /* default value */
 	qd->portal_name = NULL;
 
+	qd->dispatchedStmt = NULL;
+	qd->serializedPlan = NULL;
+	qd->serializedPlanLen = 0;
+
 	return qd;
 }
 
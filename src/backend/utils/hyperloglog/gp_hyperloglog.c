@@ -273,6 +273,8 @@ gp_hll_merge(GpHLLCounter counter1, GpHLLCounter counter2)
 	int i;
 	GpHLLCounter result = counter1;
 	int upper_bound = POW2(result->b);
+	uint8_t *dst = (uint8_t *) result->data;
+	const uint8_t *src = (const uint8_t *) counter2->data;
 
 	/* check compatibility first */
 	//if (counter1->b != counter2->b && -1*counter1->b != counter2->b)
@@ -281,9 +283,11 @@ gp_hll_merge(GpHLLCounter counter1, GpHLLCounter counter2)
 	//elog(ERROR, "bin size of estimators differs (%d != %d)", counter1->binbits, counter2->binbits);
 
 
-	/* Keep the maximum register value for each bin */
+	/* Keep the maximum register value for each bin. Registers are
+	 * unsigned bytes, and a plain max loop over them is something the
+	 * compiler can vectorize */
 	for (i = 0; i < upper_bound; i += 1){
-		result->data[i] = ((counter2->data[i] > result->data[i]) ? counter2->data[i] : result->data[i]);
+		dst[i] = Max(dst[i], src[i]);
 	}
 
 	return result;
@@ -347,21 +351,29 @@ gp_hll_estimate_dense(GpHLLCounter hloglog)
 	double H = 0, E = 0;
 	int j, V = 0;
 	int m = POW2(hloglog->b);
+	const uint8_t *regs = (const uint8_t *) hloglog->data;
+	int counts[256];
+
+	/* build a histogram of the register values. The sum for the harmonic
+	 * mean then needs only one term per distinct register value, and the
+	 * number of empty registers for linear counting falls out of the same
+	 * pass over the registers */
+	memset(counts, 0, sizeof(counts));
+	for (j = 0; j < m; j++){
+		counts[regs[j]]++;
+	}
+	V = counts[0];
 
 	/* compute the sum for the harmonic mean */
-	if (hloglog->binbits <= MAX_PRECOMPUTED_EXPONENTS_BINWIDTH){
-		for (j = 0; j < m; j++){
-			H += PE[(int)hloglog->data[j]];
+	for (j = 0; j < 256; j++){
+		if (counts[j] == 0){
+			continue;
 		}
-	}
-	else {
-		for (j = 0; j < m; j++){
-			if (0 <= hloglog->data[j] && hloglog->data[j] < NUM_OF_PRECOMPUTED_EXPONENTS){
-				H += PE[(int)hloglog->data[j]];
-			}
-			else {
-				H += pow(0.5, hloglog->data[j]);
-			}
+		if (j < NUM_OF_PRECOMPUTED_EXPONENTS){
+			H += counts[j] * PE[j];
+		}
+		else {
+			H += counts[j] * pow(0.5, j);
 		}
 	}
 
@@ -375,13 +387,6 @@ gp_hll_estimate_dense(GpHLLCounter hloglog)
 		/* account for hloglog low cardinality bias */
 		E = E - gp_error_estimate(E, hloglog->b);
 
-		/* search for empty registers for linear counting */
-		for (j = 0; j < m; j++){
-			if (hloglog->data[j] == 0){
-				V += 1;
-			}
-		}
-
 		/* Don't use linear counting if there are no empty registers since we
 		* don't to divide by 0 */
 		if (V != 0){
@@ -1083,6 +1088,7 @@ PG_FUNCTION_INFO_V1(gp_hyperloglog_add_item_agg_default);
 
 PG_FUNCTION_INFO_V1(gp_hyperloglog_merge);
 PG_FUNCTION_INFO_V1(gp_hyperloglog_get_estimate);
+PG_FUNCTION_INFO_V1(gp_hyperloglog_count_distinct_final);
 
 PG_FUNCTION_INFO_V1(gp_hyperloglog_in);
 PG_FUNCTION_INFO_V1(gp_hyperloglog_out);
@@ -1093,6 +1099,7 @@ PG_FUNCTION_INFO_V1(gp_hyperloglog_comp);
 extern Datum gp_hyperloglog_add_item_agg_default(PG_FUNCTION_ARGS);
 
 extern Datum gp_hyperloglog_get_estimate(PG_FUNCTION_ARGS);
+extern Datum gp_hyperloglog_count_distinct_final(PG_FUNCTION_ARGS);
 extern Datum gp_hyperloglog_merge(PG_FUNCTION_ARGS);
 
 extern Datum gp_hyperloglog_in(PG_FUNCTION_ARGS);
@@ -1206,6 +1213,28 @@ gp_hyperloglog_get_estimate(PG_FUNCTION_ARGS)
 	PG_RETURN_FLOAT8(estimate);
 }
 
+/* Final function of approx_count_distinct(). Unlike get_estimate, this is
+ * not strict: a NULL counter means there were no non-NULL inputs, and the
+ * count is 0, like for COUNT(DISTINCT) */
+Datum
+gp_hyperloglog_count_distinct_final(PG_FUNCTION_ARGS)
+{
+	double estimate;
+	GpHLLCounter hyperloglog;
+
+	if (PG_ARGISNULL(0)){
+		PG_RETURN_INT64(0);
+	}
+
+	hyperloglog = PG_GETARG_HLL_P_COPY(0);
+	estimate = gp_hyperloglog_estimate(hyperloglog);
+
+	/* free the hll counter copy */
+	pfree(hyperloglog);
+
+	PG_RETURN_INT64((int64) rint(estimate));
+}
+
 Datum
 gp_hyperloglog_out(PG_FUNCTION_ARGS)
 {
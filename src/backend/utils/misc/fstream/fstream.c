@@ -183,82 +183,95 @@ fstream_get_error(fstream_t*fs)
  *
  */
 
-static char*
-scan_csv_records_crlf(char *p, char* q, int one, fstream_t* fs)
+/*
+ * Return the first occurrence of 'c' in [p, q), or q if there is none.
+ *
+ * '*next' caches the result of the previous search for the same character,
+ * so that the scan below doesn't search the same data again and again for
+ * a character that appears rarely, e.g. a quote character.  Set it to NULL
+ * before the first call.
+ */
+static inline char*
+find_next_char(char *p, char *q, int c, char **next)
 {
-	int 	in_quote = 0;
-	int 	last_was_esc = 0;
-	int 	qc = fs->options.quote;
-	int 	xc = fs->options.escape;
-	char*	last_record_loc = 0;
-	int 	ch = 0;
-	int 	lastch = 0;
-
-	while (p < q)
+	if (*next == NULL || *next < p)
 	{
-		lastch = ch;
-		ch = *p++;
-
-		if (in_quote)
-		{
-			if (!last_was_esc)
-			{
-				if (ch == qc)
-					in_quote = 0;
-				else if (ch == xc)
-					last_was_esc = 1;
-			}
-			else
-				last_was_esc = 0;
-		}
-		else if (ch == '\n' && lastch == '\r')
-		{
-			last_record_loc = p;
-			fs->line_number++;
-			if (one)
-				break;
-		}
-		else if (ch == qc)
-			in_quote = 1;
+		*next = memchr(p, c, q - p);
+		if (*next == NULL)
+			*next = q;
 	}
-
-	return last_record_loc;
+	return *next;
 }
 
+/*
+ * The scan jumps from one special character to the next with memchr(),
+ * which is much faster than looking at every byte.  Outside quotes, only
+ * the quote character and the newline 'nc' matter; inside quotes, only the
+ * quote and the escape characters do.  With 'crlf', a newline only ends a
+ * record if it follows a carriage return.
+ */
 static char*
-scan_csv_records_cr_or_lf(char *p, char *q, int one, fstream_t *fs, int nc)
+scan_csv_records_internal(char *p, char *q, int one, fstream_t *fs, int nc,
+						  int crlf)
 {
+	char*	start = p;
 	int 	in_quote = 0;
-	int 	last_was_esc = 0;
 	int 	qc = fs->options.quote;
 	int 	xc = fs->options.escape;
 	char*	last_record_loc = 0;
+	char*	next_qc = NULL;
+	char*	next_xc = NULL;
+	char*	next_nc = NULL;
 
 	while (p < q)
 	{
-		int ch = *p++;
-
 		if (in_quote)
 		{
-			if (!last_was_esc)
+			char*	e = find_next_char(p, q, qc, &next_qc);
+
+			if (xc != qc)
 			{
-				if (ch == qc)
-					in_quote = 0;
-				else if (ch == xc)
-					last_was_esc = 1;
+				char*	x = find_next_char(p, q, xc, &next_xc);
+
+				if (x < e)
+				{
+					/* skip the escape character and the one after it */
+					p = x + 2;
+					continue;
+				}
 			}
-			else
-				last_was_esc = 0;
+
+			if (e == q)
+				break;
+
+			in_quote = 0;
+			p = e + 1;
 		}
-		else if (ch == nc)
+		else
 		{
-			last_record_loc = p;
-			fs->line_number++;
-			if (one)
+			char*	n = find_next_char(p, q, nc, &next_nc);
+			char*	e = find_next_char(p, q, qc, &next_qc);
+
+			if (e < n)
+			{
+				in_quote = 1;
+				p = e + 1;
+			}
+			else if (n < q)
+			{
+				p = n + 1;
+
+				if (crlf && (n == start || n[-1] != '\r'))
+					continue;
+
+				last_record_loc = p;
+				fs->line_number++;
+				if (one)
+					break;
+			}
+			else
 				break;
 		}
-		else if (ch == qc)
-			in_quote = 1;
 	}
 
 	return last_record_loc;
@@ -270,12 +283,12 @@ scan_csv_records(char *p, char *q, int one, fstream_t *fs)
 	switch(fs->options.eol_type)
 	{
 		case EOL_CRNL:
-		   return scan_csv_records_crlf(p, q, one, fs);
+		   return scan_csv_records_internal(p, q, one, fs, '\n', 1);
 		case EOL_CR:
-		   return scan_csv_records_cr_or_lf(p, q, one, fs, '\r');
+		   return scan_csv_records_internal(p, q, one, fs, '\r', 0);
 		case EOL_NL:
 		default:
-		   return scan_csv_records_cr_or_lf(p, q, one, fs, '\n');
+		   return scan_csv_records_internal(p, q, one, fs, '\n', 0);
 	}
 }
 /* close the file stream */
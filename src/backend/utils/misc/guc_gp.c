@@ -4045,6 +4045,16 @@ struct config_real ConfigureNamesReal_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_autostats_on_change_scale_factor", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Fraction of reltuples a command must modify, in addition to gp_autostats_on_change_threshold, to trigger autostats in on_change mode."),
+			gettext_noop("0 means that only gp_autostats_on_change_threshold is checked.")
+		},
+		&gp_autostats_on_change_scale_factor,
+		0.0, 0.0, 100.0,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_resqueue_priority_cpucores_per_segment", PGC_POSTMASTER, RESOURCES_MGM,
 			gettext_noop("Number of processing units associated with a segment."),
@@ -82,6 +82,7 @@
 
 #include "postgres.h"
 
+#include "storage/bufmgr.h"
 #include "utils/logtape.h"
 
 /* A logical tape block, log tape blocks are organized into doulbe linked lists */
@@ -255,6 +256,8 @@ ltsWriteBlock(LogicalTapeSet *lts, int64 blocknum, void *buffer)
 static void
 ltsReadBlock(LogicalTapeSet *lts, int64 blocknum, void *buffer)
 {
+	long		next_blk;
+
 	Assert(lts != NULL);
 	if (BufFileSeek(lts->pfile, 0 /* fileno */, blocknum * BLCKSZ, SEEK_SET) != 0 ||
 		BufFileRead(lts->pfile, buffer, BLCKSZ) != BLCKSZ)
@@ -264,6 +267,18 @@ ltsReadBlock(LogicalTapeSet *lts, int64 blocknum, void *buffer)
 				 errmsg("could not read block " INT64_FORMAT  " of temporary file: %m",
 						blocknum)));
 	}
+
+	/*
+	 * Tapes are almost always read forward, so ask the kernel to start
+	 * reading the tape's next block in the background.  Once blocks have
+	 * been recycled, a tape's blocks are scattered around the file, and
+	 * during a merge the tapes are read in interleaved order, so the OS's
+	 * own sequential read-ahead doesn't help here.  Like bitmap heap scans,
+	 * this is controlled by effective_io_concurrency.
+	 */
+	next_blk = ((LogicalTapeBlock *) buffer)->next_blk;
+	if (next_blk != -1 && target_prefetch_pages > 0)
+		BufFilePrefetchBlock(lts->pfile, next_blk);
 }
 
 /*
@@ -111,12 +111,14 @@
 #include "lib/stringinfo.h"		/* StringInfo */
 #include "miscadmin.h"
 #include "pg_trace.h"
+#include "utils/date.h"
 #include "utils/datum.h"
 #include "utils/logtape.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/pg_rusage.h"
 #include "utils/syscache.h"
+#include "utils/timestamp.h"
 #include "utils/tuplesort.h"
 #include "utils/pg_locale.h"
 #include "utils/builtins.h"
@@ -734,8 +736,21 @@ create_mksort_context(MKContext *mkctxt,
 			sinfo->typByVal = tupdesc->attrs[sinfo->attno - 1]->attbyval;
 			sinfo->typLen = tupdesc->attrs[sinfo->attno - 1]->attlen;
 
-			if (sinfo->scanKey.sk_func.fn_addr == btint4cmp)
+			/*
+			 * Types whose Datum is itself a normalized binary sort key are
+			 * compared inline, without going through the fmgr.
+			 */
+			if (sinfo->scanKey.sk_func.fn_addr == btint4cmp ||
+				sinfo->scanKey.sk_func.fn_addr == btint2cmp ||
+				sinfo->scanKey.sk_func.fn_addr == date_cmp)
 				sinfo->lvtype = MKLV_TYPE_INT32;
+			else if (sinfo->scanKey.sk_func.fn_addr == btint8cmp)
+				sinfo->lvtype = MKLV_TYPE_INT64;
+#ifdef HAVE_INT64_TIMESTAMP
+			else if (sinfo->scanKey.sk_func.fn_addr == timestamp_cmp ||
+					 sinfo->scanKey.sk_func.fn_addr == time_cmp)
+				sinfo->lvtype = MKLV_TYPE_INT64;
+#endif
 
 			/* GPDB_91_MERGE_FIXME: these MKLV_TYPE_CHAR and MKLV_TYPE_TEXT
 			 * fastpaths only work with the default collation of the database.
@@ -3156,6 +3171,14 @@ tupsort_compare_datum(MKEntry *v1, MKEntry *v2, MKLvContext *lvctxt, MKContext *
 				int32		i2 = DatumGetInt32(v2->d);
 				int			result = (i1 < i2) ? -1 : ((i1 == i2) ? 0 : 1);
 
+				return ((lvctxt->scanKey.sk_flags & SK_BT_DESC) != 0) ? -result : result;
+			}
+		case MKLV_TYPE_INT64:
+			{
+				int64		i1 = DatumGetInt64(v1->d);
+				int64		i2 = DatumGetInt64(v2->d);
+				int			result = (i1 < i2) ? -1 : ((i1 == i2) ? 0 : 1);
+
 				return ((lvctxt->scanKey.sk_flags & SK_BT_DESC) != 0) ? -result : result;
 			}
 		default:
@@ -35,6 +35,10 @@ extern bool AppendOnlyCompaction_ShouldCompact(
 								   Snapshot appendOnlyMetaDataSnapshot);
 extern void AppendOnlyThrowAwayTuple(Relation rel,
 						 TupleTableSlot *slot, MemTupleBinding *mt_bind);
+extern void AppendOnlyCompaction_VacuumDelayPoint(Relation aorel,
+									  int blocksPerRow,
+									  int64 scannedTupleCount,
+									  int64 movedTupleCount);
 extern void AppendOnlyTruncateToEOF(Relation aorel);
 extern bool HasLockForSegmentFileDrop(Relation aorel);
 extern bool AppendOnlyCompaction_IsRelationEmpty(Relation aorel);
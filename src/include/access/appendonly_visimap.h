@@ -109,6 +109,12 @@ bool AppendOnlyVisimap_IsVisible(
 							AppendOnlyVisimap *visiMap,
 							AOTupleId *tupleId);
 
+bool AppendOnlyVisimap_IsRangeVisible(
+								 AppendOnlyVisimap *visiMap,
+								 int segno,
+								 int64 firstRowNum,
+								 int64 rowCount);
+
 void AppendOnlyVisimap_Finish(
 						 AppendOnlyVisimap *visiMap,
 						 LOCKMODE lockmode);
@@ -123,6 +123,11 @@ bool AppendOnlyVisimapEntry_IsVisible(
 								 AppendOnlyVisimapEntry *visiMapEntry,
 								 AOTupleId *aoTupleId);
 
+bool AppendOnlyVisimapEntry_IsRangeVisible(
+									  AppendOnlyVisimapEntry *visiMapEntry,
+									  int64 firstRowNum,
+									  int64 lastRowNum);
+
 HTSU_Result AppendOnlyVisimapEntry_HideTuple(
 								 AppendOnlyVisimapEntry *visiMapEntry,
 								 AOTupleId *aoTupleId);
@@ -76,6 +76,14 @@ extern void InsertInitialFastSequenceEntries(Oid objid);
 extern int64 GetFastSequences(Oid objid, int64 objmod,
 							  int64 minSequence, int64 numSequences);
 
+/*
+ * ReadLastSequence
+ *
+ * Return the current lastsequence value for the given object, or 0 if
+ * there is no such entry. The entry is not modified.
+ */
+extern int64 ReadLastSequence(Oid objid, int64 objmod);
+
 /*
  * RemoveFastSequenceEntry
  *
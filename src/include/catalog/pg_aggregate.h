@@ -361,6 +361,7 @@ DATA(insert ( 6130	o 1 ordered_set_transition			percentile_cont_timestamptz_fina
 
 /* hyperloglog */
 DATA(insert ( 7164	n 0 gp_hyperloglog_add_item_agg_default gp_hyperloglog_comp		gp_hyperloglog_merge	-	-	-		-		-		f f 0	7157	0	0		0	_null_ _null_ ));
+DATA(insert ( 7167	n 0 gp_hyperloglog_add_item_agg_default gp_hyperloglog_count_distinct_final	gp_hyperloglog_merge	-	-	-		-		-		f f 0	7157	0	0		0	_null_ _null_ ));
 
 /*
  * prototypes for functions in pg_aggregate.c
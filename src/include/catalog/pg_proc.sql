@@ -203,6 +203,8 @@
 
  CREATE FUNCTION gp_request_fts_probe_scan() RETURNS bool LANGUAGE internal VOLATILE PARALLEL SAFE AS 'gp_request_fts_probe_scan' EXECUTE ON MASTER WITH (OID=5035, DESCRIPTION="Request a FTS probe scan and wait for response");
 
+ CREATE FUNCTION gp_get_idle_qe_pool_stats(OUT reused int8, OUT connected int8) RETURNS record LANGUAGE internal VOLATILE PARALLEL RESTRICTED AS 'gp_get_idle_qe_pool_stats' EXECUTE ON MASTER WITH (OID=7168, DESCRIPTION="statistics: QEs reused from the idle QE pool and newly connected by this session");
+
 
  CREATE FUNCTION cosh(float8) RETURNS float8 LANGUAGE internal IMMUTABLE PARALLEL SAFE AS 'dcosh' WITH (OID=7539, DESCRIPTION="Hyperbolic cosine function");
 
@@ -390,6 +392,10 @@ CREATE FUNCTION gp_hyperloglog_add_item_agg_default(counter gp_hyperloglog_estim
 
 CREATE FUNCTION gp_hyperloglog_accum(anyelement) RETURNS gp_hyperloglog_estimator LANGUAGE internal IMMUTABLE PARALLEL SAFE AS 'aggregate_dummy' WITH (OID=7164, proisagg="t", DESCRIPTION="Adds every data value to a gp_hyperloglog counter and returns the counter");
 
+CREATE FUNCTION gp_hyperloglog_count_distinct_final(counter gp_hyperloglog_estimator) RETURNS int8  LANGUAGE internal IMMUTABLE PARALLEL SAFE AS 'gp_hyperloglog_count_distinct_final' WITH (OID=7166, DESCRIPTION="Rounds the estimate of a gp_hyperloglog counter to an integer count, 0 if no counter");
+
+CREATE FUNCTION approx_count_distinct(anyelement) RETURNS int8 LANGUAGE internal IMMUTABLE PARALLEL SAFE AS 'aggregate_dummy' WITH (OID=7167, proisagg="t", DESCRIPTION="Approximate number of distinct non-null input values, using a gp_hyperloglog counter");
+
 CREATE FUNCTION pg_get_table_distributedby(oid) RETURNS text LANGUAGE internal STABLE STRICT PARALLEL SAFE AS 'pg_get_table_distributedby' WITH (OID=6232, DESCRIPTION="deparse DISTRIBUTED BY clause for a given relation");
 
 -- hash functions for a few built-in datatypes that are missing hash support
@@ -22,7 +22,7 @@
 
    WARNING: DO NOT MODIFY THE FOLLOWING SECTION: 
    Generated by catullus.pl version 8
-   on Thu Jan 16 20:10:09 2020
+   on Mon Oct 19 17:14:44 2026
 
    Please make your changes in pg_proc.sql
 */
@@ -417,6 +417,10 @@ DESCR("Remove a primary segment from the system catalog");
 DATA(insert OID = 5035 ( gp_request_fts_probe_scan  PGNSP PGUID 12 1 0 0 0 f f f f f f v s 0 0 16 "" _null_ _null_ _null_ _null_ _null_ gp_request_fts_probe_scan _null_ _null_ _null_ n m ));
 DESCR("Request a FTS probe scan and wait for response");
 
+/* gp_get_idle_qe_pool_stats(OUT reused int8, OUT connected int8) => record */
+DATA(insert OID = 7168 ( gp_get_idle_qe_pool_stats  PGNSP PGUID 12 1 0 0 0 f f f f f f v r 0 0 2249 "" "{20,20}" "{o,o}" "{reused,connected}" _null_ _null_ gp_get_idle_qe_pool_stats _null_ _null_ _null_ n m ));
+DESCR("statistics: QEs reused from the idle QE pool and newly connected by this session");
+
 /* cosh(float8) => float8 */
 DATA(insert OID = 7539 ( cosh  PGNSP PGUID 12 1 0 0 0 f f f f f f i s 1 0 701 "701" _null_ _null_ _null_ _null_ _null_ dcosh _null_ _null_ _null_ n a ));
 DESCR("Hyperbolic cosine function");
@@ -771,6 +775,14 @@ DESCR("Includes a data value into a gp_hyperloglog counter");
 DATA(insert OID = 7164 ( gp_hyperloglog_accum  PGNSP PGUID 12 1 0 0 0 t f f f f f i s 1 0 7157 "2283" _null_ _null_ _null_ _null_ _null_ aggregate_dummy _null_ _null_ _null_ n a ));
 DESCR("Adds every data value to a gp_hyperloglog counter and returns the counter");
 
+/* gp_hyperloglog_count_distinct_final(counter gp_hyperloglog_estimator) => int8 */
+DATA(insert OID = 7166 ( gp_hyperloglog_count_distinct_final  PGNSP PGUID 12 1 0 0 0 f f f f f f i s 1 0 20 "7157" _null_ _null_ "{counter}" _null_ _null_ gp_hyperloglog_count_distinct_final _null_ _null_ _null_ n a ));
+DESCR("Rounds the estimate of a gp_hyperloglog counter to an integer count, 0 if no counter");
+
+/* approx_count_distinct(anyelement) => int8 */
+DATA(insert OID = 7167 ( approx_count_distinct  PGNSP PGUID 12 1 0 0 0 t f f f f f i s 1 0 20 "2283" _null_ _null_ _null_ _null_ _null_ aggregate_dummy _null_ _null_ _null_ n a ));
+DESCR("Approximate number of distinct non-null input values, using a gp_hyperloglog counter");
+
 /* pg_get_table_distributedby(oid) => text */
 DATA(insert OID = 6232 ( pg_get_table_distributedby  PGNSP PGUID 12 1 0 0 0 f f f f t f s s 1 0 25 "26" _null_ _null_ _null_ _null_ _null_ pg_get_table_distributedby _null_ _null_ _null_ n a ));
 DESCR("deparse DISTRIBUTED BY clause for a given relation");
@@ -115,6 +115,13 @@ typedef struct AOCSScanDescData
 	int64 total_row;
 	int64 cur_seg_row;
 
+	/*
+	 * True if the visimap shows no hidden rows in the current block of the
+	 * first projected column, so that the per-tuple visibility checks can
+	 * be skipped.
+	 */
+	bool blockAllVisible;
+
 	/*
 	 * The block directory info.
 	 *
@@ -214,6 +221,8 @@ extern void aocs_endscan(AOCSScanDesc scan);
 extern bool aocs_getnext(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot);
 extern AOCSInsertDesc aocs_insert_init(Relation rel, int segno, bool update_mode);
 extern Oid aocs_insert_values(AOCSInsertDesc idesc, Datum *d, bool *null, AOTupleId *aoTupleId);
+extern void aocs_insert_values_multi(AOCSInsertDesc idesc, Datum **values, bool **nulls,
+									 int ntuples, AOTupleId *aoTupleIds);
 static inline Oid aocs_insert(AOCSInsertDesc idesc, TupleTableSlot *slot)
 {
 	Oid oid;
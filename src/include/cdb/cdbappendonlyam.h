@@ -194,6 +194,12 @@ typedef struct AppendOnlyScanDescData
 	/* current scan state */
 	bool		bufferDone;
 
+	/*
+	 * True if the visimap shows no hidden rows in the current block, so
+	 * that the per-tuple visibility checks can be skipped.
+	 */
+	bool		blockAllVisible;
+
 	bool	initedStorageRoutines;
 
 	AppendOnlyStorageAttributes	storageAttributes;
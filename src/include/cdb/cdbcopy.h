@@ -22,6 +22,7 @@
 #include "cdb/cdbgang.h"
 
 #define COPYOUT_CHUNK_SIZE 16 * 1024
+#define COPYIN_CHUNK_SIZE 16 * 1024
 
 struct CdbDispatcherState;
 struct CopyStateData;
@@ -38,6 +39,14 @@ typedef struct CdbCopy
 								 * data rows, it is taken out of the list */
 	HTAB		*aotupcounts;	/* hash of ao relation id to processed tuple count */
 	struct CdbDispatcherState *dispatcherState;
+
+	/*
+	 * For COPY FROM, the QE of each segment, and the data collected to be
+	 * sent to it, indexed by segindex. Rows are sent in chunks of about
+	 * COPYIN_CHUNK_SIZE bytes, rather than in one CopyData message each.
+	 */
+	struct SegmentDatabaseDescriptor **segdbs;
+	StringInfoData *copy_in_bufs;
 } CdbCopy;
 
 
@@ -16,6 +16,7 @@
 #include "nodes/plannodes.h"
 
 struct Gang;
+struct SegmentDatabaseDescriptor;
 
 /**
  * DTX states, used to track the state of the distributed transaction
@@ -233,6 +234,13 @@ typedef struct TMGXACTLOCAL
 
 	Bitmapset					*dtxSegmentsMap;
 	List						*dtxSegments;
+
+	/*
+	 * Segments whose writer QE has reported its transaction status, and
+	 * those of them that reported an assigned top-level XID.
+	 */
+	Bitmapset					*reportedSegmentsMap;
+	Bitmapset					*xidSegmentsMap;
 }	TMGXACTLOCAL;
 
 typedef struct TMGXACTSTATUS
@@ -338,6 +346,7 @@ extern void markCurrentGxactWriterGangLost(void);
 extern bool currentGxactWriterGangLost(void);
 
 extern void addToGxactDtxSegments(struct Gang* gp);
+extern void markCurrentGxactSegmentStatus(struct SegmentDatabaseDescriptor *segdbDesc);
 extern bool CurrentDtxIsRollingback(void);
 
 extern void DtxRecoveryMain(Datum main_arg);
@@ -181,6 +181,8 @@ void cdbcomponent_recycleIdleQE(struct SegmentDatabaseDescriptor *segdbDesc, boo
 bool cdbcomponent_qesExist(void);
 bool cdbcomponent_activeQEsExist(void);
 
+void cdbcomponent_getIdleQEStats(int64 *hits, int64 *misses);
+
 List *cdbcomponent_getCdbComponentsList(void);
 
 extern void writeGpSegConfigToFTSFiles(void);
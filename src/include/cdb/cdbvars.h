@@ -729,6 +729,7 @@ typedef enum
 extern int	gp_autostats_mode;
 extern int	gp_autostats_mode_in_functions;
 extern int	gp_autostats_on_change_threshold;
+extern double gp_autostats_on_change_scale_factor;
 extern bool	log_autostats;
 
 
@@ -235,6 +235,16 @@ typedef struct QueryDesc
 
 	QueryDispatchDesc *ddesc;
 
+	/*
+	 * CDB: the plan tree as last dispatched to the QEs, and its serialized
+	 * form. The initPlans and the main plan of a query are dispatched
+	 * separately, but with the same plan tree, so the serialized form can
+	 * be reused as long as plannedstmt still points to dispatchedStmt.
+	 */
+	PlannedStmt *dispatchedStmt;
+	char	   *serializedPlan;
+	int			serializedPlanLen;
+
 	/* CDB: EXPLAIN ANALYZE statistics */
 	struct CdbExplain_ShowStatCtx  *showstatctx;
 
@@ -2550,6 +2550,14 @@ typedef struct SortState
 	GenericTupStore *tuplesortstate; /* private state of tuplesort.c */
 	bool		noduplicates;	/* true if discard duplicate rows */
 
+	/*
+	 * If the input is already sorted on the leading numPresortedCols sort
+	 * columns, equality functions for those, and a slot to hold the last
+	 * tuple that must be included in a bounded sort.
+	 */
+	FmgrInfo   *presortedEqfunctions;
+	TupleTableSlot *presortedBoundSlot;
+
 	bool		delayEagerFree;		/* is is safe to free memory used by this node,
 									 * when this node has outputted its last row? */
 
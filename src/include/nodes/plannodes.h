@@ -1123,6 +1123,8 @@ typedef struct Sort
 	bool	   *nullsFirst;		/* NULLS FIRST/LAST directions */
     /* CDB */
 	bool		noduplicates;   /* TRUE if sort should discard duplicates */
+	int			numPresortedCols;	/* # of leading sort columns the input
+									 * is already sorted on */
 
 	/* Sort node can be shared */
 	ShareType 	share_type;
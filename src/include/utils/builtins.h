@@ -1406,6 +1406,9 @@ extern Datum pg_resgroup_get_status_kv(PG_FUNCTION_ARGS);
 /* utils/gdd/gddfuncs.c */
 extern Datum gp_dist_wait_status(PG_FUNCTION_ARGS);
 
+/* cdb/cdbutil.c */
+extern Datum gp_get_idle_qe_pool_stats(PG_FUNCTION_ARGS);
+
 /* utils/adt/matrix.c */
 extern Datum matrix_add(PG_FUNCTION_ARGS);
 
@@ -110,6 +110,11 @@
 		"temp_buffers",
 		"test_copy_qd_qe_split",
 		"TimeZone",
+		"vacuum_cost_delay",
+		"vacuum_cost_limit",
+		"vacuum_cost_page_dirty",
+		"vacuum_cost_page_hit",
+		"vacuum_cost_page_miss",
 		"verify_gpfdists_cert",
 		"vmem_process_interrupt",
 		"work_mem",
@@ -218,7 +218,8 @@ extern void tupsort_prepare(MKEntry *a, struct MKContext *ctxt, int lv);
 typedef enum MKLvType
 {
     MKLV_TYPE_NONE,  /* this level has not yet been assigned a type: todo: verify meaning */
-    MKLV_TYPE_INT32, /* this level contains int32 values */
+    MKLV_TYPE_INT32, /* this level contains int32 values (also int2 and date) */
+    MKLV_TYPE_INT64, /* this level contains int64 values (also integer timestamps and times) */
     MKLV_TYPE_CHAR,  /* this level contains char (blank padded) values */
     MKLV_TYPE_TEXT,  /* this level contains text values */
 } MKLvType;
@@ -147,6 +147,7 @@
 		"gp_auth_time_override",
 		"gp_autostats_mode",
 		"gp_autostats_mode_in_functions",
+		"gp_autostats_on_change_scale_factor",
 		"gp_autostats_on_change_threshold",
 		"gp_cached_segworkers_threshold",
 		"gp_command_count",
@@ -497,11 +498,6 @@
 		"unix_socket_group",
 		"unix_socket_permissions",
 		"update_process_title",
-		"vacuum_cost_delay",
-		"vacuum_cost_limit",
-		"vacuum_cost_page_dirty",
-		"vacuum_cost_page_hit",
-		"vacuum_cost_page_miss",
 		"vacuum_defer_cleanup_age",
 		"vacuum_freeze_min_age",
 		"vacuum_freeze_table_age",
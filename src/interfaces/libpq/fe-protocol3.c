@@ -185,6 +185,8 @@ pqParseInput3(PGconn *conn)
 		{
 			if (pqGetc(&conn->wrote_xlog, conn))
 				return;
+			if (pqGetc(&conn->has_top_xid, conn))
+				return;
 		}
 #endif
 		else if (conn->asyncStatus != PGASYNC_BUSY)
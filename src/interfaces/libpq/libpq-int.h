@@ -471,6 +471,7 @@ struct pg_conn
 	PGresult   *next_result;	/* next result (used in single-row mode) */
 
 	char		wrote_xlog;
+	char		has_top_xid;	/* QE has an assigned top-level XID */
 
 	/* Assorted state for SSL, GSS, etc */
 
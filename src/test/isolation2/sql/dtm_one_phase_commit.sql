@@ -0,0 +1,39 @@
+-- A distributed transaction that writes on at most one segment is committed
+-- with one-phase commit, even if it read from other segments.  Segments whose
+-- QE has an XID must take part in two-phase commit, even if they wrote no
+-- XLOG.  An error fault at dtm_broadcast_prepare on the master shows which
+-- path a commit takes.
+create table dtm_one_phase_commit (a int, b int) distributed by (a);
+insert into dtm_one_phase_commit select i, i from generate_series(1, 10) i;
+
+select gp_inject_fault('dtm_broadcast_prepare', 'error', 1);
+
+-- reads from all segments, writes to one: one-phase commit
+1: begin;
+1: select count(*) from dtm_one_phase_commit;
+1: insert into dtm_one_phase_commit values (1, 1);
+1: commit;
+
+-- writes to all segments: PREPARE is broadcast, and fails
+1: begin;
+1: select count(*) from dtm_one_phase_commit;
+1: insert into dtm_one_phase_commit select i, i from generate_series(1, 10) i;
+1: commit;
+select gp_inject_fault('dtm_broadcast_prepare', 'reset', 1);
+
+-- writes to a temp table on all segments, which needs no XLOG, and to one
+-- segment with XLOG: the temp table writes need two-phase commit too
+1: create temp table dtm_one_phase_commit_temp (a int, b int) distributed by (a);
+select gp_inject_fault('dtm_broadcast_prepare', 'error', 1);
+1: begin;
+1: insert into dtm_one_phase_commit_temp select i, i from generate_series(1, 10) i;
+1: insert into dtm_one_phase_commit values (1, 1);
+1: commit;
+select gp_inject_fault('dtm_broadcast_prepare', 'reset', 1);
+
+-- only the first transaction committed
+1: select count(*) from dtm_one_phase_commit;
+1: select count(*) from dtm_one_phase_commit_temp;
+1q:
+
+drop table dtm_one_phase_commit;
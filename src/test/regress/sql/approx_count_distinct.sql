@@ -0,0 +1,25 @@
+--
+-- Tests for approx_count_distinct(), which estimates COUNT(DISTINCT) with a
+-- gp_hyperloglog counter.
+--
+CREATE TABLE approx_cd (a int, b int, t text) DISTRIBUTED BY (a);
+INSERT INTO approx_cd SELECT i, i % 10000, 'v' || (i % 2500) FROM generate_series(1, 100000) i;
+ANALYZE approx_cd;
+
+-- Empty and all-NULL input give 0, like COUNT(DISTINCT)
+SELECT approx_count_distinct(b) FROM approx_cd WHERE a < 0;
+SELECT approx_count_distinct(NULL::int) FROM approx_cd;
+SELECT approx_count_distinct(CASE WHEN a < 0 THEN b END) FROM approx_cd;
+
+-- The counters are built on the segments and merged on the QD
+EXPLAIN (COSTS OFF) SELECT approx_count_distinct(b) FROM approx_cd;
+
+-- The estimates are within the counter's error of the exact counts
+SELECT abs(approx_count_distinct(b) - 10000) < 10000 * 0.03 AS b_ok,
+       abs(approx_count_distinct(t) - 2500) < 2500 * 0.03 AS t_ok
+  FROM approx_cd;
+SELECT a % 4 AS g,
+       abs(approx_count_distinct(b) - count(DISTINCT b)) < count(DISTINCT b) * 0.03 AS ok
+  FROM approx_cd GROUP BY 1 ORDER BY 1;
+
+DROP TABLE approx_cd;
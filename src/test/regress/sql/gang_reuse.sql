@@ -44,3 +44,16 @@ explain analyze select count(*) from test_gang_reuse_t1 a
 ;
 
 reset optimizer_force_multistage_agg;
+
+-- gp_idle_qe_pool_stats counts the QEs this session took from the idle QE
+-- pool, and the QEs it had to connect.  The queries above left their gangs
+-- in the pool, so running one of them again reuses QEs without connecting
+-- any new ones.
+select reused > 0 as reused, connected > 0 as connected from gp_idle_qe_pool_stats;
+select reused as reused_before, connected as connected_before from gp_idle_qe_pool_stats
+\gset
+select count(*) from test_gang_reuse_t1 a
+  join test_gang_reuse_t1 b using (c2);
+select reused > :reused_before as reused_more,
+       connected = :connected_before as none_connected
+  from gp_idle_qe_pool_stats;
@@ -43,6 +43,29 @@ select octet_length(t) from enctest;
 select * from enctest;
 copy enctest to stdout;
 
+-- In encodings like SJIS, the second byte of a multi-byte character can be
+-- an ASCII byte. U+8868 is 0x95 0x5C in SJIS; COPY FROM must not take its
+-- second byte for a backslash, after runs of every length within a word or
+-- around the end of the 64 kB raw input buffer. The first 16 rows are 65537
+-- bytes long in the file, so that the buffer ends at a different offset
+-- around the character in each of them.
+\c utf8db
+CREATE TABLE sjistest (id int, t text) DISTRIBUTED BY (id);
+CREATE TABLE sjistest_in (id int, t text) DISTRIBUTED BY (id);
+insert into sjistest
+  select 100 + k, repeat('z', 65524) || chr(34920) || repeat('y', 6)
+  from generate_series(0, 15) k;
+insert into sjistest
+  select 200 + p, repeat('x', p) || chr(34920) || repeat('y', 15 - p) || E'\\'
+  from generate_series(0, 15) p;
+copy (select * from sjistest order by id) to '/tmp/enctest_sjis' encoding 'sjis';
+copy sjistest_in from '/tmp/enctest_sjis' encoding 'sjis';
+select count(*) from sjistest_in;
+select count(*) from
+  ((select * from sjistest except all select * from sjistest_in)
+   union all
+   (select * from sjistest_in except all select * from sjistest)) d;
+
 \c regression
 drop database utf8db;
 drop database latin1db;
@@ -56,3 +56,24 @@ explain select distinct(a), sum(b) from t_volatile_limit_1 group by a order by a
 
 drop table t_volatile_limit;
 drop table t_volatile_limit_1;
+
+-- A bounded Sort whose input is already ordered on a prefix of the sort
+-- keys stops reading its input after the prefix group of the last row it
+-- can return. The view's ORDER BY makes the planner see the input to the
+-- outer Sort as ordered by a.
+create view presorted_limit_input as
+  select * from (select i / 5 as a, i % 3 as b from generate_series(1, 30) i order by a offset 0) s;
+-- cut-off in the middle of a group of ties
+select * from presorted_limit_input order by a, b limit 5;
+select * from presorted_limit_input order by a, b limit 3 offset 4;
+-- rescan with a different bound each time
+select x, (select sum(a * 10 + b) from (select * from presorted_limit_input order by a, b limit x) l) as s
+from generate_series(2, 11, 3) x;
+-- same results with a plain sort of the whole input
+set gp_enable_sort_limit = off;
+select * from presorted_limit_input order by a, b limit 5;
+select * from presorted_limit_input order by a, b limit 3 offset 4;
+select x, (select sum(a * 10 + b) from (select * from presorted_limit_input order by a, b limit x) l) as s
+from generate_series(2, 11, 3) x;
+reset gp_enable_sort_limit;
+drop view presorted_limit_input;
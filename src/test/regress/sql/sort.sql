@@ -119,3 +119,30 @@ insert into colltest VALUES ('a'), ('A'), ('b'), ('B'), ('c'), ('C'), ('d'), ('D
 
 select * from colltest order by t COLLATE "C";
 select * from colltest order by t COLLATE "C" NULLS FIRST;
+
+--
+-- Test the inline comparisons of int2, date and int8 leading keys in mk sort,
+-- with negative values, NULLs and duplicates.
+--
+set gp_enable_mk_sort = on;
+create table mksort_keys (id int, s int2, d date, b int8) distributed by (id);
+insert into mksort_keys values
+  (1, -32768, '1999-12-31', -9223372036854775808),
+  (2, -1, '2000-01-01', -1),
+  (3, -1, '1999-12-31', 0),
+  (4, 0, '2000-01-02', 1),
+  (5, null, '2000-01-01', null),
+  (6, 32767, null, 9223372036854775807),
+  (7, 1, '1970-01-01', -4294967296),
+  (8, 1, '1970-01-01', 4294967296),
+  (9, -1, null, -1),
+  (10, null, null, null),
+  (11, 0, '2000-01-02', 1),
+  (12, -300, '2038-01-19', 2147483648);
+select s, d, b from mksort_keys order by s, d, b;
+select s, d, b from mksort_keys order by s desc, d desc, b desc;
+select s, d, b from mksort_keys order by d, b desc, s;
+select s, d, b from mksort_keys order by d desc nulls last, s nulls first, b;
+select s, d, b from mksort_keys order by b, s, d;
+select s, d, b from mksort_keys order by b desc, d, s desc;
+reset gp_enable_mk_sort;
@@ -0,0 +1,33 @@
+-- @Description Tests that ANALYZE samples a large AO table through its block directory.
+CREATE TABLE uao_blkdir_sample (a INT, b INT, c TEXT) WITH (appendonly=true) DISTRIBUTED BY (a);
+CREATE INDEX uao_blkdir_sample_index ON uao_blkdir_sample(a);
+INSERT INTO uao_blkdir_sample SELECT i, i % 10, 'row ' || i FROM generate_series(1, 30000) AS i;
+-- compact segment file 1 into segment file 2, and then hide more rows there
+DELETE FROM uao_blkdir_sample WHERE a % 5 = 0;
+VACUUM uao_blkdir_sample;
+SELECT segno, sum(tupcount) AS tupcount FROM (
+  SELECT (gp_toolkit.__gp_aoseg('uao_blkdir_sample')).* FROM gp_dist_random('gp_id')
+) AS s GROUP BY segno ORDER BY segno;
+DELETE FROM uao_blkdir_sample WHERE a % 7 = 0;
+SELECT count(*) FROM uao_blkdir_sample;
+
+-- The fault is hit only when the sample is collected through the block directory.
+SELECT gp_inject_fault_infinite('analyze_ao_blkdir_sample', 'skip', dbid)
+  FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+-- Each segment returns up to 300 sampled rows, none of them deleted, and
+-- reports its live rows in the summary row.
+SELECT count(*) FILTER (WHERE totalrows IS NULL) BETWEEN 3 * 250 AND 3 * 300 AS sample_size_ok,
+       count(*) FILTER (WHERE a % 5 = 0 OR a % 7 = 0) AS deleted_in_sample,
+       sum(totalrows) AS totalrows,
+       sum(totaldeadrows) AS totaldeadrows
+  FROM gp_acquire_sample_rows('uao_blkdir_sample'::regclass, 300, false)
+    AS (totalrows float8, totaldeadrows float8, oversized_cols_bitmap text,
+        a int, b int, c text);
+SET default_statistics_target = 1;
+ANALYZE uao_blkdir_sample;
+RESET default_statistics_target;
+SELECT gp_wait_until_triggered_fault('analyze_ao_blkdir_sample', 2, dbid)
+  FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+SELECT gp_inject_fault('analyze_ao_blkdir_sample', 'reset', dbid)
+  FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+SELECT reltuples FROM pg_class WHERE relname = 'uao_blkdir_sample';
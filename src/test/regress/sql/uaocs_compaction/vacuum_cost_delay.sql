@@ -0,0 +1,21 @@
+-- @Description Test that vacuum_cost_delay throttles compaction of AOCS tables
+CREATE TABLE uaocs_cost_delay (a INT, b INT, c TEXT) WITH (appendonly=true, orientation=column) DISTRIBUTED BY (a);
+INSERT INTO uaocs_cost_delay SELECT i, i, repeat('x', 100) FROM generate_series(1, 10000) AS i;
+-- dropped columns don't count towards the blocks read per row
+ALTER TABLE uaocs_cost_delay DROP COLUMN b;
+DELETE FROM uaocs_cost_delay WHERE a % 2 = 0;
+
+-- The fault is hit only when compaction is about to sleep.
+SELECT gp_inject_fault('appendonly_compaction_vacuum_delay', 'skip', dbid)
+  FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+SET vacuum_cost_delay = 1;
+SET vacuum_cost_limit = 1;
+VACUUM uaocs_cost_delay;
+RESET vacuum_cost_delay;
+RESET vacuum_cost_limit;
+SELECT gp_wait_until_triggered_fault('appendonly_compaction_vacuum_delay', 1, dbid)
+  FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+SELECT gp_inject_fault('appendonly_compaction_vacuum_delay', 'reset', dbid)
+  FROM gp_segment_configuration WHERE role = 'p' AND content = 0;
+
+SELECT COUNT(*) FROM uaocs_cost_delay;
@@ -788,3 +788,72 @@ SELECT to_char(SUM(n::float8) OVER (ORDER BY i ROWS BETWEEN CURRENT ROW AND 1 FO
 SELECT i, b, bool_and(b) OVER w, bool_or(b) OVER w
   FROM (VALUES (1,true), (2,true), (3,false), (4,false), (5,true)) v(i,b)
   WINDOW w AS (ORDER BY i ROWS BETWEEN CURRENT ROW AND 1 FOLLOWING);
+
+-- Frames whose head moves, for aggregates without an inverse transition
+-- function, are evaluated with the combine function.  Check them against
+-- restarting the aggregation for every row, which is what happens when an
+-- argument contains a volatile function.
+create table wcombine (p int, k int, v float8) distributed by (p);
+insert into wcombine
+  select i % 3, i / 3,
+         case when i % 7 = 0 or i / 3 between 40 and 45 then null
+              else (i * 37) % 23 end
+  from generate_series(0, 299) i;
+-- non-strict transition and combine functions; NULL inputs count as 1000
+create function wcombine_sfunc(int8, float8) returns int8
+  as $$ select coalesce($1, 0) + coalesce($2::int8, 1000) $$
+  language sql immutable;
+create function wcombine_cfunc(int8, int8) returns int8
+  as $$ select case when $1 is null then $2 when $2 is null then $1
+                    else $1 + $2 end $$
+  language sql immutable;
+create aggregate wcombine_sum(float8) (
+  sfunc = wcombine_sfunc, stype = int8, combinefunc = wcombine_cfunc);
+
+-- compare each aggregate over the given window ordering and frame with the
+-- same aggregate restarted for every row, and count the rows that differ
+create function wcombine_check(frame text)
+returns table (nrows bigint, min bigint, max bigint, sum bigint, avg bigint,
+               stddev bigint, textmin bigint, nonstrict bigint) as $$
+begin
+  return query execute format($q$
+    select count(*),
+           sum((mn is distinct from mn_r)::int),
+           sum((mx is distinct from mx_r)::int),
+           sum((sm is distinct from sm_r)::int),
+           sum((av is distinct from av_r)::int),
+           sum((sd is distinct from sd_r)::int),
+           sum((tm is distinct from tm_r)::int),
+           sum((ns is distinct from ns_r)::int)
+    from (select min(v) over w as mn, min(v + 0 * random()) over w as mn_r,
+                 max(v) over w as mx, max(v + 0 * random()) over w as mx_r,
+                 sum(v) over w as sm, sum(v + 0 * random()) over w as sm_r,
+                 avg(v) over w as av, avg(v + 0 * random()) over w as av_r,
+                 stddev(v) over w as sd, stddev(v + 0 * random()) over w as sd_r,
+                 min(v::text) over w as tm,
+                 min((v + 0 * random())::text) over w as tm_r,
+                 wcombine_sum(v) over w as ns,
+                 wcombine_sum(v + 0 * random()) over w as ns_r
+          from (select p, k, k / 4 as g, v from wcombine) t
+          window w as (partition by p %s)) s$q$, frame);
+end
+$$ language plpgsql;
+
+select * from wcombine_check('order by k rows between 2 preceding and current row');
+select * from wcombine_check('order by k rows between 1 preceding and 2 following');
+select * from wcombine_check('order by k rows between 3 preceding and 1 preceding');
+select * from wcombine_check('order by k rows between 1 following and 3 following');
+select * from wcombine_check('order by g range between 2 preceding and 1 following');
+select * from wcombine_check('order by g range between current row and 1 following');
+select * from wcombine_check('order by k rows between current row and unbounded following');
+-- a frame wider than the suffix states are kept for restarts instead
+insert into wcombine
+  select 3, i, case when i % 11 = 0 then null else (i * 37) % 23 end
+  from generate_series(0, 1099) i;
+select * from wcombine_check('order by k rows between 1030 preceding and current row');
+
+drop function wcombine_check(text);
+drop aggregate wcombine_sum(float8);
+drop function wcombine_sfunc(int8, float8);
+drop function wcombine_cfunc(int8, int8);
+drop table wcombine;
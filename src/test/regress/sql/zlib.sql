@@ -83,3 +83,24 @@ drop table test_zlib_t1;
 drop table test_zlib_hashjoin;
 
 select gp_inject_fault('workfile_creation_failure', 'reset', 2);
+
+-- Spill data that doesn't compress. The spill files give up on compression
+-- after the first few kB and are written uncompressed instead; check that
+-- they're still read back correctly. The hash join rewinds its batch files
+-- with BufFileSeek(), and the hash agg suspends and resumes its spill files.
+create table test_zlib_incompressible (i int, b bytea) distributed by (i);
+insert into test_zlib_incompressible
+  select i, decode(md5(i::text) || md5(i::text || 'a') || md5(i::text || 'b') || md5(i::text || 'c') ||
+                   md5(i::text || 'd') || md5(i::text || 'e') || md5(i::text || 'f') || md5(i::text || 'g'), 'hex')
+  from generate_series(1, 100000) i;
+set statement_mem = '2MB';
+set enable_mergejoin = off;
+set enable_nestloop = off;
+set enable_sort = off;
+select count(*) from test_zlib_incompressible t1 join test_zlib_incompressible t2 on t1.i = t2.i and t1.b = t2.b;
+select count(*), count(distinct n) from (select b, count(*) as n from test_zlib_incompressible group by b) g;
+reset statement_mem;
+reset enable_mergejoin;
+reset enable_nestloop;
+reset enable_sort;
+drop table test_zlib_incompressible;